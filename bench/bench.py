@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+# bench.py - benchmark harness for fieldSAT
+# Copyright (C) 2025 fieldbox
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the Free
+# Software Foundation, either version 3 of the License, or (at your option)
+# any later version. See COPYING for details.
+
+"""Run fieldSAT over a corpus and compare the results against a baseline.
+
+Every instance is solved once with a per-instance timeout, recording the
+answer, the wall time and the conflict and propagation rates reported by
+--stats=json. The run is scored by PAR-2 (the mean time, counting unsolved
+instances as twice the timeout) and written as CSV and JSON. Given a
+baseline (the JSON of an earlier run), every instance is compared against
+it, and the microbenchmarks are run if their binary is given.
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import generate  # noqa: E402
+
+
+def expected_answer(path):
+    """The answer given by a "c expect" line at the top of the file, if any."""
+    try:
+        with open(path) as f:
+            for line in f:
+                if not line.startswith("c"):
+                    break
+                words = line.split()
+                if len(words) == 3 and words[1] == "expect":
+                    return words[2]
+    except UnicodeDecodeError:  # compressed input
+        pass
+    return "UNKNOWN"
+
+
+def run_instance(solver, args, path, timeout):
+    start = time.monotonic()
+    try:
+        process = subprocess.run([solver, "--stats=json"] + args + [path],
+                                 stdout=subprocess.PIPE, timeout=timeout,
+                                 universal_newlines=True)
+        output = process.stdout
+    except subprocess.TimeoutExpired:
+        output = ""
+    seconds = time.monotonic() - start
+
+    answer, stats = "UNKNOWN", {}
+    for line in output.splitlines():
+        if line.startswith("{"):
+            stats = json.loads(line)
+        elif line in ("s SATISFIABLE", "s UNSATISFIABLE"):
+            answer = "SAT" if line == "s SATISFIABLE" else "UNSAT"
+    if answer == "UNKNOWN":
+        seconds = timeout
+    rate = lambda key: stats.get(key, 0) / max(stats.get("seconds", 0), 1e-9)
+    return {
+        "instance": os.path.basename(path),
+        "answer": answer,
+        "expected": expected_answer(path),
+        "seconds": round(seconds, 4),
+        "conflicts": stats.get("conflicts", 0),
+        "propagations": stats.get("propagations", 0),
+        "conflicts_per_second": round(rate("conflicts")),
+        "propagations_per_second": round(rate("propagations")),
+    }
+
+
+def par2(results, timeout):
+    scores = [r["seconds"] if r["answer"] != "UNKNOWN" else 2 * timeout
+              for r in results]
+    return sum(scores) / max(len(scores), 1)
+
+
+def run_micro(binary):
+    output = subprocess.run([binary, "--csv"], stdout=subprocess.PIPE,
+                            universal_newlines=True, check=True).stdout
+    rows = list(csv.DictReader(output.splitlines()))
+    return {row["benchmark"]: float(row["items_per_second"]) for row in rows}
+
+
+def compare(run, baseline):
+    """Print how the run differs from the baseline, instance by instance.
+    returns false if the run gave an answer contradicting the baseline."""
+    old = {r["instance"]: r for r in baseline["instances"]}
+    consistent = True
+    ratios = []
+    print("\n%-24s %10s %10s %8s" % ("instance", "baseline", "now", "ratio"))
+    for r in run["instances"]:
+        b = old.get(r["instance"])
+        if b is None:
+            continue
+        if "UNKNOWN" not in (r["answer"], b["answer"]) and \
+                r["answer"] != b["answer"]:
+            print("%-24s answer changed from %s to %s" %
+                  (r["instance"], b["answer"], r["answer"]))
+            consistent = False
+        ratio = b["seconds"] / max(r["seconds"], 1e-3)
+        if r["answer"] != "UNKNOWN" and b["answer"] != "UNKNOWN":
+            ratios.append(ratio)
+        print("%-24s %10.3f %10.3f %7.2fx" %
+              (r["instance"], b["seconds"], r["seconds"], ratio))
+    print("\nPAR-2 %.3f -> %.3f, solved %d -> %d" %
+          (baseline["par2"], run["par2"], baseline["solved"], run["solved"]))
+    if ratios:
+        mean = math.exp(sum(map(math.log, ratios)) / len(ratios))
+        print("geometric mean speedup on instances solved by both: %.3fx"
+              % mean)
+    for name, rate in sorted(run.get("micro", {}).items()):
+        if name in baseline.get("micro", {}):
+            print("micro %-10s %14.0f -> %14.0f per second (%+.1f%%)" %
+                  (name, baseline["micro"][name], rate,
+                   100 * (rate / baseline["micro"][name] - 1)))
+    return consistent
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--solver", required=True, help="fieldSAT binary")
+    parser.add_argument("--corpus", required=True,
+                        help="directory of .cnf files. the generated corpus "
+                             "is written here if it does not exist yet")
+    parser.add_argument("--timeout", type=float, default=60,
+                        help="seconds per instance (default 60)")
+    parser.add_argument("--output", default="bench_results",
+                        help="results are written to OUTPUT.csv and "
+                             "OUTPUT.json")
+    parser.add_argument("--baseline", help="JSON results to compare against")
+    parser.add_argument("--micro", help="microbenchmark binary to run too")
+    parser.add_argument("--args", default="",
+                        help="extra solver options, as one string")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.corpus):
+        print("generated %d instances in %s" %
+              (generate.generate(args.corpus), args.corpus))
+    paths = sorted(os.path.join(args.corpus, name)
+                   for name in os.listdir(args.corpus)
+                   if ".cnf" in name)
+
+    results = []
+    wrong = []
+    for path in paths:
+        r = run_instance(args.solver, args.args.split(), path, args.timeout)
+        results.append(r)
+        if r["expected"] != "UNKNOWN" and \
+                r["answer"] not in ("UNKNOWN", r["expected"]):
+            wrong.append(r["instance"])
+        print("%-24s %-8s %9.3fs %10d conflicts/s %12d propagations/s" %
+              (r["instance"], r["answer"], r["seconds"],
+               r["conflicts_per_second"], r["propagations_per_second"]),
+              flush=True)
+
+    run = {
+        "solver": args.solver,
+        "args": args.args,
+        "timeout": args.timeout,
+        "solved": sum(r["answer"] != "UNKNOWN" for r in results),
+        "par2": round(par2(results, args.timeout), 4),
+        "instances": results,
+    }
+    if args.micro:
+        run["micro"] = run_micro(args.micro)
+    print("\nsolved %d of %d, PAR-2 %.3f" %
+          (run["solved"], len(results), run["par2"]))
+    for name, rate in sorted(run.get("micro", {}).items()):
+        print("micro %-10s %14.0f per second" % (name, rate))
+
+    with open(args.output + ".csv", "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=list(results[0].keys())
+                                if results else ["instance"])
+        writer.writeheader()
+        writer.writerows(results)
+    with open(args.output + ".json", "w") as f:
+        json.dump(run, f, indent=2)
+    print("results written to %s.csv and %s.json" % (args.output, args.output))
+
+    consistent = True
+    if args.baseline:
+        with open(args.baseline) as f:
+            consistent = compare(run, json.load(f))
+    for instance in wrong:
+        print("wrong answer on %s" % instance)
+    return 0 if consistent and not wrong else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# generate.py - benchmark corpus for fieldSAT
+# Copyright (C) 2025 fieldbox
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the Free
+# Software Foundation, either version 3 of the License, or (at your option)
+# any later version. See COPYING for details.
+
+"""Write a fixed corpus of CNF instances modelled on SATLIB families.
+
+Every instance comes from a fixed seed, so the corpus is the same on every
+machine and runs can be compared. Each file starts with a comment line
+"c expect SAT", "c expect UNSAT" or "c expect UNKNOWN", which bench.py uses
+to catch wrong answers.
+"""
+
+import argparse
+import os
+import random
+
+
+def write(path, num_vars, clauses, expect, family):
+    with open(path, "w") as f:
+        f.write("c expect %s\nc family %s\n" % (expect, family))
+        f.write("p cnf %d %d\n" % (num_vars, len(clauses)))
+        for clause in clauses:
+            f.write(" ".join(map(str, clause)) + " 0\n")
+
+
+def random_ksat(rng, num_vars, num_clauses, k):
+    """Uniform random k-SAT, as in the SATLIB uf/uuf families."""
+    clauses = []
+    for _ in range(num_clauses):
+        variables = rng.sample(range(1, num_vars + 1), k)
+        clauses.append([v if rng.random() < 0.5 else -v for v in variables])
+    return clauses
+
+
+def pigeonhole(holes):
+    """holes + 1 pigeons in holes holes, as in the SATLIB hole family."""
+    var = lambda pigeon, hole: pigeon * holes + hole + 1
+    clauses = [[var(p, h) for h in range(holes)] for p in range(holes + 1)]
+    for h in range(holes):
+        for p in range(holes + 1):
+            for q in range(p + 1, holes + 1):
+                clauses.append([-var(p, h), -var(q, h)])
+    return (holes + 1) * holes, clauses
+
+
+def flat_colouring(rng, vertices, edges, colours=3):
+    """Graph colouring of a random graph with a planted colouring, as in the
+    SATLIB flat family, so every instance is satisfiable."""
+    colour = [rng.randrange(colours) for _ in range(vertices)]
+    var = lambda v, c: v * colours + c + 1
+    clauses = [[var(v, c) for c in range(colours)] for v in range(vertices)]
+    for v in range(vertices):
+        for c in range(colours):
+            for d in range(c + 1, colours):
+                clauses.append([-var(v, c), -var(v, d)])
+    found = set()
+    while len(found) < edges:
+        u, v = rng.sample(range(vertices), 2)
+        if colour[u] != colour[v] and (v, u) not in found:
+            found.add((u, v))
+    for u, v in sorted(found):
+        for c in range(colours):
+            clauses.append([-var(u, c), -var(v, c)])
+    return vertices * colours, clauses
+
+
+def xor_clauses(a, b, out):
+    """out = a xor b."""
+    return [[-a, -b, -out], [a, b, -out], [a, -b, out], [-a, b, out]]
+
+
+def xor3_clauses(a, b, c, parity):
+    """a xor b xor c = parity: every assignment of the wrong parity is ruled
+    out by one clause."""
+    clauses = []
+    for signs in range(8):
+        values = [(signs >> i) & 1 for i in range(3)]
+        if sum(values) % 2 != parity:
+            clauses.append([v if not value else -v
+                            for v, value in zip((a, b, c), values)])
+    return clauses
+
+
+def dubois(n):
+    """2n xor constraints on 3n variables, in which every variable occurs
+    twice, with one constraint of the wrong parity, as in the SATLIB dubois
+    family. unsatisfiable, but easy for clause learning."""
+    cycle = list(range(1, 2 * n + 1))  # each shared by neighbouring constraints
+    clauses = []
+    for k in range(2 * n):
+        shared = 2 * n + 1 + min(k, 2 * n - 1 - k)  # by constraints k, 2n-1-k
+        clauses += xor3_clauses(cycle[k], cycle[(k + 1) % (2 * n)], shared,
+                                0 if k == 0 else 1)
+    return 3 * n, clauses
+
+
+def parity_miter(rng, n):
+    """Two xor chains over the same inputs, in different orders, asserted to
+    differ. unsatisfiable, and hard for resolution as n grows."""
+    clauses = []
+    next_var = [n + 1]
+
+    def chain(order):
+        acc = order[0]
+        for x in order[1:]:
+            out = next_var[0]
+            next_var[0] += 1
+            clauses.extend(xor_clauses(acc, x, out))
+            acc = out
+        return acc
+
+    inputs = list(range(1, n + 1))
+    first = chain(inputs)
+    shuffled = inputs[:]
+    rng.shuffle(shuffled)
+    second = chain(shuffled)
+    clauses += [[first, second], [-first, -second]]
+    return next_var[0] - 1, clauses
+
+
+def generate(directory):
+    families = []  # (name, num_vars, clauses, expect)
+    for n in (150, 200, 250):
+        for seed in range(1, 6):
+            rng = random.Random(1000 * n + seed)
+            families.append(("uf%d-%02d" % (n, seed), n,
+                             random_ksat(rng, n, int(4.26 * n), 3), "UNKNOWN"))
+    for seed in range(1, 4):
+        rng = random.Random(5000 + seed)
+        families.append(("k5-50-%02d" % seed, 50,
+                         random_ksat(rng, 50, 1050, 5), "UNKNOWN"))
+    for holes in (7, 8, 9):
+        families.append(("hole%d" % holes,) + pigeonhole(holes) + ("UNSAT",))
+    for vertices in (100, 150, 200):
+        for seed in range(1, 3):
+            rng = random.Random(7000 * vertices + seed)
+            num_vars, clauses = flat_colouring(rng, vertices,
+                                               int(2.4 * vertices))
+            families.append(("flat%d-%02d" % (vertices, seed), num_vars,
+                             clauses, "SAT"))
+    for n in (50, 100, 200):
+        families.append(("dubois%d" % n,) + dubois(n) + ("UNSAT",))
+    for n in (20, 24, 28, 32):
+        rng = random.Random(9000 + n)
+        families.append(("parity%d" % n,) + parity_miter(rng, n) + ("UNSAT",))
+
+    os.makedirs(directory, exist_ok=True)
+    for name, num_vars, clauses, expect in families:
+        family = name.rstrip("0123456789-")
+        write(os.path.join(directory, name + ".cnf"), num_vars, clauses, expect,
+              family)
+    return len(families)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("directory", help="where to write the instances")
+    args = parser.parse_args()
+    print("wrote %d instances" % generate(args.directory))
@@ -0,0 +1,270 @@
+/* micro.cpp - microbenchmarks for the solver's hot paths
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+// each benchmark runs one hot path on a fixed workload, generated from a
+// fixed seed, so that a regression in parse(), propagate() or analyse() shows
+// up on its own rather than being hidden in the noise of a whole search
+
+#include "solver.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+struct Measurement {
+  const char *name;
+  const char *unit; // what the items counted are
+  double seconds;
+  long long items;
+};
+
+uint64_t next_random(uint64_t &state) { // xorshift64, as in Solver::random()
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+std::vector<std::vector<int>> random_3sat(int num_vars, double ratio,
+                                          uint64_t seed) {
+  std::vector<std::vector<int>> clauses(num_vars * ratio);
+  for (std::vector<int> &clause : clauses) {
+    while (clause.size() < 3) {
+      int var = next_random(seed) % num_vars + 1;
+      if (std::find(clause.begin(), clause.end(), var) == clause.end() &&
+          std::find(clause.begin(), clause.end(), -var) == clause.end())
+        clause.push_back(next_random(seed) & 1 ? var : -var);
+    }
+  }
+  return clauses;
+}
+
+void load(Solver &solver, const std::vector<std::vector<int>> &clauses) {
+  for (const std::vector<int> &clause : clauses) {
+    solver.add_clause(clause);
+  }
+  solver.initialise();
+}
+
+struct Decider { // decides variables in a random order, drawn afresh for
+                // every round
+  std::vector<int> order;
+  size_t next = 0; // order[0, next) is the part of this round's order drawn
+  uint64_t seed;
+  bool negative = false; // whether every variable is decided false, rather
+                         // than in a random phase
+
+  Decider(const Solver &solver, uint64_t seed) : seed(seed) {
+    for (int var = 1; var <= solver.num_vars; var++) {
+      order.push_back(var);
+    }
+  }
+
+  void restart() { next = 0; }
+
+  bool decide(Solver &solver) { // assume the next unassigned variable, in a
+                                // random phase. the order is shuffled lazily,
+                                // so a round only costs as much as its
+                                // decisions. returns false once every
+                                // variable is assigned
+    while (next < order.size()) {
+      std::swap(order[next],
+                order[next + next_random(seed) % (order.size() - next)]);
+      int var = order[next++];
+      if (solver.value_of_var(var) == UNASSIGNED) {
+        solver.assume(make_literal(var, negative || next_random(seed) & 1));
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+Measurement bench_parse(int rounds) { // parse a large random 3-SAT file
+  char path[] = "/tmp/fieldsat_micro_XXXXXX";
+  int fd = mkstemp(path);
+  FILE *file = fdopen(fd, "w");
+  std::vector<std::vector<int>> clauses = random_3sat(200000, 4.26, 1);
+  fprintf(file, "p cnf 200000 %zu\n", clauses.size());
+  for (const std::vector<int> &clause : clauses) {
+    fprintf(file, "%d %d %d 0\n", clause[0], clause[1], clause[2]);
+  }
+  fclose(file);
+
+  double best = 1e30;
+  for (int round = 0; round < rounds; round++) {
+    Solver solver;
+    Clock::time_point start = Clock::now();
+    solver.parse(path);
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  unlink(path);
+  return {"parse", "clauses", best, (long long)clauses.size()};
+}
+
+Measurement bench_propagate(int rounds) { // propagate random decisions from
+                                          // the root level down to a
+                                          // conflict, many times over
+  Solver solver;
+  load(solver, random_3sat(100000, 4.2, 2));
+  Decider decider(solver, 3);
+  double seconds = 0;
+  long long start_propagations = solver.num_propagations;
+  for (int round = 0; round < rounds; round++) {
+    decider.restart();
+    Clock::time_point start = Clock::now(); // deciding is cheap next to
+                                            // propagating, and timing each
+                                            // call would cost more than it
+    while (decider.decide(solver) && solver.propagate<NoTrace>()) {
+    }
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    solver.backtrack(0);
+  }
+  return {"propagate", "literals", seconds,
+          solver.num_propagations - start_propagations};
+}
+
+Measurement bench_large(int rounds) { // as bench_propagate, on a formula
+                                      // whose clauses and watch lists take
+                                      // about 700 MB, more than the last
+                                      // level cache of most machines
+  const int num_vars = 4000000;
+  Solver solver;
+  uint64_t seed = 8;
+  std::vector<int> clause;
+  for (long long i = 0; i < num_vars * 4.2; i++) { // added straight away,
+                                                  // since a copy of every
+                                                  // clause would need as
+                                                  // much memory again
+    clause.clear();
+    while (clause.size() < 3) {
+      int var = next_random(seed) % num_vars + 1;
+      if (std::find(clause.begin(), clause.end(), var) == clause.end() &&
+          std::find(clause.begin(), clause.end(), -var) == clause.end())
+        clause.push_back(next_random(seed) & 1 ? var : -var);
+    }
+    solver.add_clause(clause);
+  }
+  solver.initialise();
+  Decider decider(solver, 9);
+  double seconds = 0;
+  long long start_propagations = solver.num_propagations;
+  for (int round = 0; round < rounds; round++) {
+    decider.restart();
+    Clock::time_point start = Clock::now();
+    while (decider.decide(solver) && solver.propagate<NoTrace>()) {
+    }
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    solver.backtrack(0);
+  }
+  return {"large", "literals", seconds,
+          solver.num_propagations - start_propagations};
+}
+
+Measurement bench_long(int rounds) { // propagate negative decisions on long
+                                     // positive clauses, so that each watch
+                                     // has to skip over many false literals
+                                     // to find its replacement
+  const int num_vars = 2000;
+  std::vector<std::vector<int>> clauses(4000);
+  uint64_t seed = 6;
+  for (std::vector<int> &clause : clauses) {
+    int size = 100 + next_random(seed) % 200;
+    while (clause.size() < size) {
+      int var = next_random(seed) % num_vars + 1;
+      if (std::find(clause.begin(), clause.end(), var) == clause.end())
+        clause.push_back(var);
+    }
+  }
+  Solver solver;
+  load(solver, clauses);
+  Decider decider(solver, 7);
+  decider.negative = true;
+  double seconds = 0;
+  long long start_propagations = solver.num_propagations;
+  for (int round = 0; round < rounds; round++) {
+    decider.restart();
+    Clock::time_point start = Clock::now();
+    while (decider.decide(solver) && solver.propagate<NoTrace>()) {
+    }
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    solver.backtrack(0);
+  }
+  return {"long", "literals", seconds,
+          solver.num_propagations - start_propagations};
+}
+
+Measurement bench_analyse(int rounds) { // analyse the conflicts reached by
+                                        // random decisions on a formula at
+                                        // the threshold. the learned clauses
+                                        // are dropped, so every round sees
+                                        // similar conflicts
+  Solver solver;
+  load(solver, random_3sat(5000, 4.26, 4));
+  Decider decider(solver, 5);
+  double seconds = 0;
+  long long conflicts = 0;
+  for (int round = 0; round < rounds; round++) {
+    decider.restart();
+    while (decider.decide(solver)) {
+      if (!solver.propagate<NoTrace>()) {
+        Clock::time_point start = Clock::now();
+        solver.analyse();
+        seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        conflicts++;
+        break;
+      }
+    }
+    solver.backtrack(0);
+  }
+  return {"analyse", "conflicts", seconds, conflicts};
+}
+
+Measurement best_of(int repeats, Measurement (*bench)(int), int rounds) {
+  Measurement best = bench(rounds); // the fastest run is the one least
+                                    // disturbed by the rest of the machine
+  for (int i = 1; i < repeats; i++) {
+    Measurement measurement = bench(rounds);
+    if (measurement.seconds < best.seconds)
+      best = measurement;
+  }
+  return best;
+}
+
+int main(int argc, char *argv[]) {
+  bool csv = argc > 1 && strcmp(argv[1], "--csv") == 0;
+  Measurement results[] = {bench_parse(5), best_of(3, bench_propagate, 100),
+                           bench_large(5), best_of(3, bench_long, 100),
+                           best_of(3, bench_analyse, 10000)};
+  if (csv)
+    printf("benchmark,seconds,items,unit,items_per_second\n");
+  else
+    printf("%-12s %10s %12s %-10s %14s\n", "benchmark", "seconds", "items",
+           "", "per second");
+  for (const Measurement &result : results) {
+    printf(csv ? "%s,%.6f,%lld,%s,%.0f\n"
+               : "%-12s %10.4f %12lld %-10s %14.0f\n",
+           result.name, result.seconds, result.items, result.unit,
+           result.items / result.seconds);
+  }
+  return 0;
+}
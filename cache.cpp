@@ -0,0 +1,275 @@
+/* cache.cpp - cached results and saved search state
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+
+struct FileHeader {
+  char magic[8];
+  uint64_t hash[2];
+  int32_t num_vars;
+  int32_t unused = 0; // so the header has no padding, and compares whole
+};
+
+const char cache_magic[8] = {'F', 'S', 'C', 'A', 'C', 'H', 'E', '1'};
+const char state_magic[8] = {'F', 'S', 'S', 'T', 'A', 'T', 'E', '1'};
+
+FileHeader make_header(const Solver &solver, const char *magic) {
+  FileHeader header;
+  memcpy(header.magic, magic, sizeof(header.magic));
+  header.hash[0] = solver.hash.words[0];
+  header.hash[1] = solver.hash.words[1];
+  header.num_vars = solver.num_vars;
+  return header;
+}
+
+std::string cache_path(const Solver &solver, const char *directory) {
+  char name[48];
+  snprintf(name, sizeof(name), "/%016llx%016llx.result",
+           (unsigned long long)solver.hash.words[0],
+           (unsigned long long)solver.hash.words[1]);
+  return directory + std::string(name);
+}
+
+Result cache_lookup(Solver &solver, const char *directory) {
+  FILE *file = fopen(cache_path(solver, directory).c_str(), "rb");
+  if (!file)
+    return RESULT_UNKNOWN;
+  FileHeader header, expected = make_header(solver, cache_magic);
+  int32_t result = RESULT_UNKNOWN;
+  std::vector<uint64_t> bits((solver.num_vars + 64) / 64);
+  bool read =
+      fread(&header, sizeof(header), 1, file) == 1 &&
+      memcmp(&header, &expected, sizeof(header)) == 0 &&
+      fread(&result, sizeof(result), 1, file) == 1 &&
+      (result != RESULT_SAT ||
+       fread(bits.data(), sizeof(uint64_t), bits.size(), file) == bits.size());
+  fclose(file);
+  if (!read || (result != RESULT_SAT && result != RESULT_UNSAT))
+    return RESULT_UNKNOWN;
+  if (result == RESULT_UNSAT)
+    return RESULT_UNSAT;
+
+  solver.model.assign(solver.num_vars + 1, FALSE);
+  for (int var = 1; var <= solver.num_vars; var++) {
+    if ((bits[var >> 6] >> (var & 63)) & 1)
+      solver.model[var] = TRUE;
+  }
+  for (CRef ref : solver.clauses) { // the hash only makes a collision
+                                    // unlikely, and the file may be stale
+    bool satisfied = false;
+    for (int literal : solver.arena[ref]) {
+      if (solver.model[var_of(literal)] ==
+          (is_negative(literal) ? FALSE : TRUE)) {
+        satisfied = true;
+        break;
+      }
+    }
+    if (!satisfied)
+      return RESULT_UNKNOWN;
+  }
+  return RESULT_SAT;
+}
+
+void cache_store(const Solver &solver, const char *directory, Result result) {
+  std::string path = cache_path(solver, directory);
+  std::string temporary = path + "." + std::to_string(getpid());
+  FILE *file = fopen(temporary.c_str(), "wb");
+  if (!file)
+    return;
+  FileHeader header = make_header(solver, cache_magic);
+  int32_t value = result;
+  std::vector<uint64_t> bits((solver.num_vars + 64) / 64);
+  if (result == RESULT_SAT) {
+    for (int var = 1; var <= solver.num_vars; var++) {
+      if (solver.model[var] == TRUE)
+        bits[var >> 6] |= 1ull << (var & 63);
+    }
+  }
+  bool written =
+      fwrite(&header, sizeof(header), 1, file) == 1 &&
+      fwrite(&value, sizeof(value), 1, file) == 1 &&
+      (result != RESULT_SAT ||
+       fwrite(bits.data(), sizeof(uint64_t), bits.size(), file) == bits.size());
+  if (fclose(file) != 0 || !written ||
+      rename(temporary.c_str(), path.c_str()) != 0)
+    remove(temporary.c_str());
+}
+
+void write_varint(std::vector<char> &out, unsigned value) { // as in
+                                                            // ProofWriter
+  while (value > 127) {
+    out.push_back((char)(value | 128));
+    value >>= 7;
+  }
+  out.push_back((char)value);
+}
+
+bool read_varint(FILE *file, unsigned &value) {
+  value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    int byte = getc(file);
+    if (byte == EOF)
+      return false;
+    value |= (unsigned)(byte & 127) << shift;
+    if (byte < 128)
+      return true;
+  }
+  return false;
+}
+
+bool save_state(Solver &solver, const char *path) {
+  FILE *file = fopen(path, "wb");
+  if (!file)
+    return false;
+  FileHeader header = make_header(solver, state_magic);
+  int num_vars = solver.num_vars;
+
+  double max_activity = 0;
+  for (int var = 1; var <= num_vars; var++) {
+    max_activity = std::max(max_activity, solver.activity[var]);
+  }
+  std::vector<float> activities(num_vars);
+  std::vector<uint64_t> phases((num_vars + 64) / 64);
+  for (int var = 1; var <= num_vars; var++) {
+    activities[var - 1] =
+        max_activity > 0 ? solver.activity[var] / max_activity : 0;
+    if (solver.last_assignments[var] == TRUE)
+      phases[var >> 6] |= 1ull << (var & 63);
+  }
+
+  std::vector<char> encoded; // the learned clauses
+  uint32_t num_learned = 0;
+  solver.backtrack(0);
+  for (int literal : solver.trail) { // root level units, which are on the
+                                     // trail rather than in clauses
+    write_varint(encoded, 1);
+    write_varint(encoded, 1);
+    write_varint(encoded, literal);
+    num_learned++;
+  }
+  for (CRef ref : solver.learned_clauses) {
+    Clause &clause = solver.arena[ref];
+    if (clause.lbd > state_max_lbd)
+      continue;
+    write_varint(encoded, clause.lbd);
+    write_varint(encoded, clause.size);
+    for (int literal : clause) {
+      write_varint(encoded, literal);
+    }
+    num_learned++;
+  }
+
+  bool written =
+      fwrite(&header, sizeof(header), 1, file) == 1 &&
+      fwrite(activities.data(), sizeof(float), num_vars, file) == num_vars &&
+      fwrite(phases.data(), sizeof(uint64_t), phases.size(), file) ==
+          phases.size() &&
+      fwrite(&num_learned, sizeof(num_learned), 1, file) == 1 &&
+      fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+  return fclose(file) == 0 && written;
+}
+
+bool load_state(Solver &solver, const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (!file)
+    return false;
+  FileHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      memcmp(header.magic, state_magic, sizeof(state_magic)) != 0 ||
+      header.num_vars < 0) {
+    fclose(file);
+    return false;
+  }
+  std::vector<float> activities(header.num_vars);
+  std::vector<uint64_t> phases((header.num_vars + 64) / 64);
+  if (fread(activities.data(), sizeof(float), header.num_vars, file) !=
+          header.num_vars ||
+      fread(phases.data(), sizeof(uint64_t), phases.size(), file) !=
+          phases.size()) {
+    fclose(file);
+    return false;
+  }
+
+  if (!solver.initialised)
+    solver.initialise();
+  int shared = std::min(solver.num_vars, (int)header.num_vars);
+  for (int var = 1; var <= shared; var++) {
+    solver.activity[var] =
+        1 + activities[var - 1]; // above the variables the state does not
+                                 // cover, which start at 1, and on the
+                                 // scale of the first bumps
+    solver.last_assignments[var] =
+        (phases[var >> 6] >> (var & 63)) & 1 ? TRUE : FALSE;
+  }
+  solver.order_heap.heap.clear(); // rebuilt for the new activities
+  solver.order_heap.indices.assign(solver.num_vars + 1, -1);
+  for (int var = 1; var <= solver.num_vars; var++) {
+    if (!solver.eliminated[var])
+      solver.order_heap.insert(var);
+  }
+
+  uint32_t num_learned = 0;
+  bool read = true;
+  if (header.hash[0] == solver.hash.words[0] &&
+      header.hash[1] == solver.hash.words[1] &&
+      header.num_vars == solver.num_vars &&
+      fread(&num_learned, sizeof(num_learned), 1, file) == 1) {
+    std::vector<int> literals;
+    solver.backtrack(0);
+    for (uint32_t i = 0; i < num_learned && read && !solver.empty_clause;
+         i++) {
+      unsigned lbd, size, literal;
+      read = read_varint(file, lbd) && read_varint(file, size);
+      literals.clear();
+      bool usable = true; // false once the clause is satisfied at the root,
+                          // or has an eliminated variable
+      for (unsigned k = 0; k < size && read; k++) {
+        read = read_varint(file, literal);
+        if (!read || literal < 2 || var_of(literal) > solver.num_vars) {
+          read = false;
+        } else if (solver.eliminated[var_of(literal)] ||
+                   solver.value_of(literal) == TRUE) {
+          usable = false;
+        } else if (solver.value_of(literal) == UNASSIGNED) {
+          literals.push_back(literal);
+        }
+      }
+      if (!read || !usable)
+        continue;
+      std::sort(literals.begin(), literals.end());
+      literals.erase(std::unique(literals.begin(), literals.end()),
+                     literals.end());
+      if (literals.empty()) {
+        solver.empty_clause = true;
+      } else if (literals.size() == 1) {
+        solver.assign_implied<NoTrace>(literals[0], CREF_UNDEF);
+      } else {
+        CRef c = solver.add_learned(literals);
+        solver.arena[c].lbd = std::min<unsigned>(
+            {lbd, solver.arena[c].lbd, max_lbd});
+        solver.arena[c].tier = solver.tier_for(solver.arena[c].lbd);
+      }
+    }
+  }
+  fclose(file);
+  return read;
+}
@@ -0,0 +1,66 @@
+/* cache.h - cached results and saved search state
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_CACHE_H
+#define FIELDSAT_CACHE_H
+
+#include "solver.h"
+
+// both kinds of file are binary, in the byte order of the machine, and start
+// with an 8-byte magic string, the formula's FormulaHash and its number of
+// variables.
+//
+// a cached result, in DIR/<hash>.result, then has the result (as a 32-bit
+// Result) and, if it is RESULT_SAT, the model as one bit per variable from
+// variable 1, set if the variable is true.
+//
+// a saved state has each variable's activity as a float, scaled so that the
+// largest is 1, and its saved phase as one bit, as in a model. then comes the
+// number of learned clauses (32 bits), followed by each clause as its LBD and
+// size and then its literals in the solver's encoding, all written 7 bits at
+// a time as in a binary DRAT proof
+
+const int state_max_lbd =
+    tier2_lbd_limit; // learned clauses with an LBD up to this are saved
+
+Result cache_lookup(Solver &solver,
+                    const char *directory); // the cached result for the
+                                            // parsed formula, with the model
+                                            // in solver.model, or
+                                            // RESULT_UNKNOWN. a cached model
+                                            // is checked against the clauses
+                                            // before it is used
+void cache_store(const Solver &solver, const char *directory,
+                 Result result); // record the result found for the parsed
+                                 // formula, and solver.model if it is
+                                 // RESULT_SAT. the file is written under
+                                 // another name and renamed, so readers
+                                 // never see part of it
+bool save_state(Solver &solver,
+                const char *path); // write the activities, saved phases and
+                                   // low LBD learned clauses
+bool load_state(Solver &solver,
+                const char *path); // read them back into a solver that has
+                                   // parsed (and preprocessed) its formula,
+                                   // initialising it. activities and phases
+                                   // are loaded for whichever variables the
+                                   // two formulas share, but the learned
+                                   // clauses only if the formula has the
+                                   // same hash, since they may not follow
+                                   // from any other. returns false if the
+                                   // file could not be read
+
+#endif
@@ -0,0 +1,176 @@
+/* components.cpp - solving independent parts of a formula separately
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "components.h"
+
+#include <mutex>
+#include <thread>
+
+int find_root(std::vector<int> &parents, int var) { // union-find lookup, with
+                                                   // path halving
+  while (parents[var] != var) {
+    parents[var] = parents[parents[var]];
+    var = parents[var];
+  }
+  return var;
+}
+
+bool split_components(Solver &solver, Components &parts) {
+  std::vector<int> parents(solver.num_vars + 1);
+  for (int var = 0; var <= solver.num_vars; var++) {
+    parents[var] = var;
+  }
+  for (CRef ref : solver.clauses) {
+    Clause &clause = solver.arena[ref];
+    int root = find_root(parents, var_of(clause[0]));
+    for (int i = 1; i < clause.size; i++) {
+      int other = find_root(parents, var_of(clause[i]));
+      if (other != root) { // the smaller root stays, so every root is found
+                           // again in the same place
+        parents[std::max(root, other)] = std::min(root, other);
+        root = std::min(root, other);
+      }
+    }
+  }
+
+  std::vector<int> sizes(solver.num_vars + 1); // clauses of each component,
+                                               // indexed by root
+  for (CRef ref : solver.clauses) {
+    sizes[find_root(parents, var_of(solver.arena[ref][0]))]++;
+  }
+  std::vector<int> part_of(solver.num_vars + 1, -1); // indexed by root
+  int small_part = -1; // part that small components are added to, until it
+                       // has enough clauses
+  parts.clauses.clear();
+  for (CRef ref : solver.clauses) {
+    int root = find_root(parents, var_of(solver.arena[ref][0]));
+    if (part_of[root] < 0) {
+      if (sizes[root] < component_min_clauses) {
+        if (small_part < 0 ||
+            parts.clauses[small_part].size() >= component_min_clauses) {
+          small_part = parts.clauses.size();
+          parts.clauses.emplace_back();
+        }
+        part_of[root] = small_part;
+      } else {
+        part_of[root] = parts.clauses.size();
+        parts.clauses.emplace_back();
+      }
+    }
+    parts.clauses[part_of[root]].push_back(ref);
+  }
+  if (parts.clauses.size() < 2)
+    return false;
+
+  parts.vars.assign(parts.clauses.size(), {});
+  parts.local_vars.assign(solver.num_vars + 1, 0);
+  for (int p = 0; p < parts.clauses.size(); p++) {
+    for (CRef ref : parts.clauses[p]) {
+      for (int literal : solver.arena[ref]) {
+        int var = var_of(literal);
+        if (parts.local_vars[var] == 0) {
+          parts.vars[p].push_back(var);
+          parts.local_vars[var] = parts.vars[p].size();
+        }
+      }
+    }
+  }
+  return true;
+}
+
+int stop_set(void *stop) { // terminate callback of the solver of a part
+  return static_cast<std::atomic<bool> *>(stop)->load(
+      std::memory_order_relaxed);
+}
+
+Result solve_components(Solver &solver, const Components &parts,
+                        int num_threads, bool verbose) {
+  std::vector<int> order(parts.clauses.size()); // largest part first, so the
+                                                // threads finish together
+  for (int p = 0; p < order.size(); p++) {
+    order[p] = p;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return parts.clauses[a].size() > parts.clauses[b].size();
+  });
+
+  solver.model.assign(solver.num_vars + 1,
+                      FALSE); // variables in no clause keep this value
+  std::atomic<bool> unsatisfiable{false};
+  std::atomic<int> next{0}; // index into order of the next part to solve
+  std::mutex stats_mutex;   // guards the statistics of solver
+  auto solve_parts = [&](int thread) {
+    std::vector<int> clause;
+    while (!unsatisfiable.load(std::memory_order_relaxed)) {
+      int n = next.fetch_add(1);
+      if (n >= order.size())
+        return;
+      int p = order[n];
+      Solver part; // built here rather than up front, so only the parts
+                   // being solved take up memory
+      part.use_restart_policy(solver.restart_policy);
+      part.initial_phase = solver.initial_phase;
+      part.activity_decay = solver.activity_decay;
+      part.walk_enabled = solver.walk_enabled;
+      part.gauss_enabled = solver.gauss_enabled;
+      part.progress_interval =
+          thread == 0 ? solver.progress_interval
+                      : 0; // only the first thread reports, as only the first
+                           // solver of a portfolio does
+      part.terminate = stop_set;
+      part.terminate_data = &unsatisfiable;
+      for (CRef ref : parts.clauses[p]) {
+        clause.clear();
+        for (int literal : solver.arena[ref]) {
+          int var = parts.local_vars[var_of(literal)];
+          clause.push_back(is_negative(literal) ? -var : var);
+        }
+        part.add_clause(clause);
+      }
+
+      Result result = verbose && thread == 0 // the trace is only written
+                                             // by the first thread
+                          ? part.solve<VerboseTrace>()
+                          : part.solve<NoTrace>();
+      if (result == RESULT_UNSAT) {
+        unsatisfiable.store(true, std::memory_order_relaxed);
+      } else if (result == RESULT_SAT) {
+        const std::vector<int> &vars = parts.vars[p];
+        for (int i = 0; i < vars.size(); i++) {
+          solver.model[vars[i]] = part.model[i + 1]; // the parts share no
+                                                     // variables, so no two
+                                                     // threads write the
+                                                     // same entry
+        }
+      }
+      std::lock_guard<std::mutex> lock(stats_mutex);
+      solver.add_stats(part);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < std::min<int>(num_threads, order.size()); t++) {
+    threads.emplace_back(solve_parts, t);
+  }
+  solve_parts(0);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  if (unsatisfiable.load())
+    return RESULT_UNSAT;
+  solver.restore_eliminated();
+  return RESULT_SAT;
+}
@@ -0,0 +1,51 @@
+/* components.h - solving independent parts of a formula separately
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_COMPONENTS_H
+#define FIELDSAT_COMPONENTS_H
+
+#include "solver.h"
+
+const int component_min_clauses =
+    1000; // connected components with fewer clauses than this are packed
+          // together into parts of at least this many, rather than each
+          // getting a solver of its own
+
+struct Components { // the clauses of a formula, split into parts that share
+                    // no variables, so each can be solved by itself
+  std::vector<std::vector<CRef>> clauses; // the clauses of each part
+  std::vector<std::vector<int>> vars; // the variables of each part. in the
+                                      // part's own solver, vars[p][i] is
+                                      // variable i + 1
+  std::vector<int> local_vars; // the number of each variable in its part's
+                               // solver, indexed by variable
+};
+
+bool split_components(Solver &solver,
+                      Components &parts); // find the connected components of
+                                          // the solver's clauses, which must
+                                          // not be initialised yet. returns
+                                          // false if there is only one part
+Result solve_components(Solver &solver, const Components &parts,
+                        int num_threads,
+                        bool verbose); // solve the parts on num_threads
+                                       // threads, largest first, stopping as
+                                       // soon as one is unsatisfiable. the
+                                       // model is left in solver.model, and
+                                       // the statistics of every part are
+                                       // added to the solver's
+
+#endif
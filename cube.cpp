@@ -0,0 +1,355 @@
+/* cube.cpp - distributed cube-and-conquer solving
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "cube.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+[[noreturn]] void network_error(const char *message) {
+  std::cerr << "error: " << message << ": " << strerror(errno) << std::endl;
+  exit(1);
+}
+
+struct Connection { // one end of a line based connection
+  int fd = -1;
+  std::string input; // bytes received but not yet taken as lines
+  bool idle = false; // coordinator side: whether the worker waits for a cube
+  int cube = -1;     // coordinator side: the cube the worker is solving
+
+  bool send(const std::string &line) {
+    size_t sent = 0;
+    while (sent < line.size()) {
+      ssize_t n = ::send(fd, line.data() + sent, line.size() - sent,
+                         MSG_NOSIGNAL); // a closed peer is noticed by the
+                                        // return value, not SIGPIPE
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        return false;
+      sent += n;
+    }
+    return true;
+  }
+
+  bool receive() { // read what has arrived, returning false once closed
+    char buffer[1 << 16];
+    ssize_t n;
+    do {
+      n = read(fd, buffer, sizeof(buffer));
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+      return false;
+    input.append(buffer, n);
+    return true;
+  }
+
+  bool next_line(std::string &line) { // take the next complete line, if any
+    size_t end = input.find('\n');
+    if (end == std::string::npos)
+      return false;
+    line.assign(input, 0, end);
+    input.erase(0, end + 1);
+    return true;
+  }
+};
+
+bool read_literals(const char *&pos, std::vector<int> &literals) { // read
+                                                                   // numbers
+                                                                   // up to a
+                                                                   // zero
+  literals.clear();
+  while (true) {
+    char *end;
+    long literal = strtol(pos, &end, 10);
+    if (end == pos)
+      return false; // the line ended before the zero
+    pos = end;
+    if (literal == 0)
+      return true;
+    literals.push_back(literal);
+  }
+}
+
+bool satisfies(Solver &solver,
+               const std::vector<Value> &model) { // whether a worker's model
+                                                  // agrees with the root
+                                                  // assignments and satisfies
+                                                  // the clauses, which any
+                                                  // model of the input does
+  for (int literal : solver.trail) {
+    if (solver.var_info[var_of(literal)].level == 0 &&
+        model[var_of(literal)] != (is_negative(literal) ? FALSE : TRUE))
+      return false;
+  }
+  for (CRef ref : solver.clauses) {
+    bool satisfied = false;
+    for (int literal : solver.arena[ref]) {
+      if (model[var_of(literal)] == (is_negative(literal) ? FALSE : TRUE)) {
+        satisfied = true;
+        break;
+      }
+    }
+    if (!satisfied)
+      return false;
+  }
+  return true;
+}
+
+std::string cube_message(int id, const Cube &cube) {
+  std::string line = "CUBE " + std::to_string(id);
+  for (int literal : cube) {
+    line += " " + std::to_string(literal);
+  }
+  return line + " 0\n";
+}
+
+Result coordinate(Solver &solver, int port, int depth) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  if (listener < 0)
+    network_error("could not create socket");
+  int reuse = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 ||
+      listen(listener, 64) != 0)
+    network_error("could not listen");
+
+  std::vector<Cube> cubes; // workers connecting meanwhile wait in the backlog
+  if (!solver.make_cubes(depth, cubes) || cubes.empty()) {
+    close(listener);
+    return RESULT_UNSAT; // refuted while looking ahead
+  }
+  std::cerr << "c split into " << cubes.size() << " cubes, listening on port "
+            << port << std::endl;
+
+  std::vector<int> pending; // cubes not handed out, next one last
+  for (int id = cubes.size() - 1; id >= 0; id--) {
+    pending.push_back(id);
+  }
+  std::vector<char> refuted(cubes.size());
+  size_t num_refuted = 0;
+  std::vector<Connection> workers;
+  std::vector<pollfd> fds;
+  std::vector<int> model;
+  std::vector<Value> values;
+  std::string line;
+  Result result = RESULT_UNKNOWN;
+
+  while (result == RESULT_UNKNOWN) {
+    fds.assign(1, {listener, POLLIN, 0});
+    for (Connection &worker : workers) {
+      fds.push_back({worker.fd, POLLIN, 0});
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      network_error("poll failed");
+    }
+
+    for (int i = 0; i < workers.size() && result == RESULT_UNKNOWN; i++) {
+      Connection &worker = workers[i];
+      if (fds[i + 1].revents == 0)
+        continue;
+      if (!worker.receive()) { // the worker went away, so its cube is handed
+                               // to someone else
+        if (worker.cube >= 0 && !refuted[worker.cube])
+          pending.push_back(worker.cube);
+        close(worker.fd);
+        worker.fd = -1;
+        continue;
+      }
+      while (result == RESULT_UNKNOWN && worker.next_line(line)) {
+        const char *pos = line.c_str();
+        if (line == "READY") {
+          worker.idle = true;
+        } else if (line.compare(0, 6, "UNSAT ") == 0) {
+          int id = atoi(pos + 6);
+          if (id >= 0 && id < cubes.size() && !refuted[id]) {
+            refuted[id] = true; // a cube can be solved twice, if it was
+                                // handed out again
+            num_refuted++;
+          }
+          worker.idle = true;
+          worker.cube = -1;
+          if (num_refuted == cubes.size())
+            result = RESULT_UNSAT;
+        } else if (line.compare(0, 4, "SAT ") == 0) {
+          pos += 4;
+          strtol(pos, (char **)&pos, 10); // the cube id
+          if (!read_literals(pos, model))
+            continue;
+          values.assign(solver.num_vars + 1, FALSE);
+          for (int literal : model) {
+            if (std::abs(literal) <= solver.num_vars)
+              values[std::abs(literal)] = literal > 0 ? TRUE : FALSE;
+          }
+          if (satisfies(solver, values)) {
+            solver.model.swap(values);
+            result = RESULT_SAT;
+          } else { // a faulty worker, or one solving another formula. its
+                   // cube is handed to someone else
+            std::cerr << "c ignoring a worker whose model does not satisfy "
+                         "the formula"
+                      << std::endl;
+            if (worker.cube >= 0 && !refuted[worker.cube])
+              pending.push_back(worker.cube);
+            close(worker.fd);
+            worker.fd = -1;
+            break;
+          }
+        }
+      }
+    }
+    workers.erase(std::remove_if(workers.begin(), workers.end(),
+                                 [](const Connection &worker) {
+                                   return worker.fd < 0;
+                                 }),
+                  workers.end());
+
+    if (fds[0].revents & POLLIN) {
+      int fd = accept(listener, nullptr, nullptr);
+      if (fd >= 0) {
+        workers.emplace_back();
+        workers.back().fd = fd;
+      }
+    }
+
+    for (Connection &worker : workers) {
+      if (!worker.idle || pending.empty() || result != RESULT_UNKNOWN)
+        continue;
+      int id = pending.back();
+      if (refuted[id]) { // refuted by another worker since it was requeued
+        pending.pop_back();
+        continue;
+      }
+      if (worker.send(cube_message(id, cubes[id]))) {
+        pending.pop_back();
+        worker.idle = false;
+        worker.cube = id;
+      }
+    }
+  }
+
+  for (Connection &worker : workers) { // stop the workers still solving
+    worker.send("DONE\n");
+    close(worker.fd);
+  }
+  close(listener);
+  return result;
+}
+
+struct WorkerState { // passed to the terminate callback of a worker
+  int fd;
+  int calls = 0;
+};
+
+int told_to_stop(void *data) { // while a cube is being solved, the only
+                                // thing the coordinator sends is DONE, so
+                                // any input (or a closed connection) means
+                                // the search can stop. checked every so often
+                                // rather than after every conflict
+  WorkerState &state = *static_cast<WorkerState *>(data);
+  if (++state.calls % 1024 != 0)
+    return 0;
+  pollfd fd = {state.fd, POLLIN, 0};
+  return poll(&fd, 1, 0) > 0;
+}
+
+bool work(Solver &solver, const char *address) {
+  std::string host = address;
+  size_t colon = host.rfind(':');
+  if (colon == std::string::npos) {
+    std::cerr << "error: expected host:port, got " << address << std::endl;
+    exit(1);
+  }
+  std::string port = host.substr(colon + 1);
+  host.resize(colon);
+
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *addresses;
+  if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0)
+    return false;
+  Connection coordinator;
+  for (addrinfo *a = addresses; a && coordinator.fd < 0; a = a->ai_next) {
+    int fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+    if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+      close(fd);
+      fd = -1;
+    }
+    coordinator.fd = fd;
+  }
+  freeaddrinfo(addresses);
+  if (coordinator.fd < 0)
+    return false;
+
+  WorkerState state = {coordinator.fd};
+  solver.terminate = told_to_stop;
+  solver.terminate_data = &state;
+
+  std::string line;
+  Cube cube;
+  if (!coordinator.send("READY\n"))
+    return true;
+  while (true) {
+    while (!coordinator.next_line(line)) {
+      if (!coordinator.receive())
+        return true; // the coordinator has finished
+    }
+    if (line.compare(0, 5, "CUBE ") != 0)
+      return true; // DONE
+    const char *pos = line.c_str() + 5;
+    std::string id = std::to_string(strtol(pos, (char **)&pos, 10));
+    if (!read_literals(pos, cube))
+      return true;
+    for (int literal : cube) {
+      int var = std::abs(literal);
+      if (var > solver.num_vars || solver.eliminated[var]) {
+        std::cerr << "error: cube contains eliminated variable " << var
+                  << "; run the worker with the coordinator's options"
+                  << std::endl;
+        exit(1);
+      }
+    }
+
+    Result result = solver.solve(cube);
+    if (result == RESULT_UNKNOWN)
+      return true; // told to stop
+    std::string reply = (result == RESULT_SAT ? "SAT " : "UNSAT ") + id;
+    if (result == RESULT_SAT) {
+      for (int var = 1; var <= solver.num_vars; var++) {
+        reply += " " + std::to_string(solver.value(var) == TRUE ? var : -var);
+      }
+      reply += " 0";
+    }
+    if (!coordinator.send(reply + "\n"))
+      return true;
+  }
+}
@@ -0,0 +1,44 @@
+/* cube.h - distributed cube-and-conquer solving
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_CUBE_H
+#define FIELDSAT_CUBE_H
+
+#include "solver.h"
+
+// cube-and-conquer: a coordinator splits the formula into cubes with
+// Solver::make_cubes(), and hands them out one at a time to workers, which
+// may run on other machines. the protocol is line based, over TCP:
+//
+//   worker:      READY                       once connected
+//   coordinator: CUBE <id> <literals> 0      the next cube to solve, or
+//                DONE                        once the answer is known
+//   worker:      UNSAT <id>                  the cube has no model, or
+//                SAT <id> <model> 0          a model, as DIMACS literals
+//
+// workers solve every cube with the same incremental solver, so clauses
+// learned on one cube help with the next. they must be given the same input
+// and options as the coordinator, so that preprocessing leaves them with the
+// same formula
+
+Result coordinate(Solver &solver, int port,
+                  int depth); // returns RESULT_SAT with the model in
+                              // solver.model, or RESULT_UNSAT
+bool work(Solver &solver,
+          const char *address); // address is host:port. returns false if the
+                                // coordinator could not be reached
+
+#endif
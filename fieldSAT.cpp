@@ -13,572 +13,396 @@ PARTICULAR PURPOSE. See the GNU General Public License for more details.
 You should have received a copy of the GNU General Public License along with
 this program. If not, see <https://www.gnu.org/licenses/>.*/
 
-#include <algorithm>
-#include <cmath>
-#include <cstdlib>
-#include <cstring>
-#include <iostream>
-#include <ostream>
-#include <string>
-#include <vector>
-
-struct Clause {
-  std::vector<int> literals;
-  int watch1;
-  int watch2;
-  double activity = 0;   // only relevant for learned clauses
-  bool toRemove = false; // only relevant for learned clauses
-};
-
-enum Value { TRUE, FALSE, UNASSIGNED };
-
-bool verbose = false;
-
-int num_vars, num_clauses;
-std::vector<Clause *> clauses;
-
-std::vector<int> trail; // all assignments in chronological order
-int trail_head = 0;     // index of the most recently propagated assignment
-
-std::vector<Value> assignments; // all assignments, indexed by variable
-int assigned_vars = 0;          // number of variables that are assigned
-
-std::vector<Value> last_assignments; // last assignment to each variable,
-                                     // ignoring backtracking. used when
-                                     // deciding a variable's value, and
-                                     // defaults to false
 
-std::vector<std::vector<Clause *>>
-    watchers; // contains lists of all clauses watching a literal, indexed by
-              // literal using get_literal_index()
+#include "cache.h"
+#include "components.h"
+#include "cube.h"
+#include "server.h"
+#include "solver.h"
 
-std::vector<int> trail_decisions; // index of the beginning of each decision
-                                  // level in the trail
-std::vector<int>
-    decision_levels; // decision level each variable was assigned at
-
-std::vector<Clause *> reasons; // clause that implies each variable's value
-
-Clause *conflict_clause; // most recent conflict clause
-
-std::vector<double> activity; // activity of a variable, indexed by variable
-const double activity_inc =
-    1; // amount to increment activity by when a conflict is found
-const double activity_decay =
-    0.95; // amount to decay activity by when a conflict is found
-
-std::vector<Clause *> learned_clauses; // pointers to all learned clauses
-int num_conflicts;                     // number of conflicts that have occurred
-const int reduction_threshold =
-    3000; // threshold of number of conflicts before the clause list is reduced
-const double clause_activity_inc =
-    1; // amount to increase clause activity by when a conflict is found
-const double clause_activity_decay =
-    0.95; // amount to decay clause activity by when a conflict is found
-
-int max_conflicts =
-    100; // threshold of number of conflicts before solver is restarted
-
-int get_literal_index(
-    int literal) { // some lists are indexed by literal, which can be positive
-                   // or negative (but not 0). this function maps the positive
-                   // and negative integers to the natural numbers to work as
-                   // indices for these lists.
-  return (literal > 0) ? 2 * literal - 1 : 2 * -literal - 2;
-}
+#include <cerrno>
+#include <iostream>
+#include <string>
+#include <thread>
 
-Value value_of(int literal) { // get the value of a literal
-  Value assignment = assignments[std::abs(literal)];
-  if (assignment == UNASSIGNED) {
-    return UNASSIGNED;
-  }
+#include <unistd.h>
 
-  int signbit = assignment == TRUE
-                    ? 0
-                    : 1; // if true, then positive, i.e. sign bit will be 1
-  if (std::signbit(literal) ==
-      signbit) { // if the sign bits are equal, then the literals are equal. so
-                 // if that literal is in the assignment list, then it is true
-    return TRUE;
-  } else {
-    return FALSE;
-  }
+Result solve(Solver &solver, bool verbose) { // search for a model of the
+                                              // preprocessed formula, which is
+                                              // left in solver.model
+  return verbose ? solver.solve<VerboseTrace>() : solver.solve<NoTrace>();
 }
 
-bool propagate() { // propagate any literals queued in the trail, then the
-                   // literals from any unit clauses onto the trail
-  while (trail_head < trail.size()) {
-    int literal = trail[trail_head];
-    int index = get_literal_index(-literal);
-
-    if (verbose)
-      std::cout << "propagating " << literal << "..." << std::endl;
-
-    for (int i = 0; i < watchers[index].size();) {
-      Clause &clause = *watchers[index][i];
-      int watch_num, other_watch;
-      if (clause.literals[clause.watch1] == -literal) {
-        watch_num = 1;
-        other_watch = clause.literals[clause.watch2];
-      } else {
-        watch_num = 2;
-        other_watch = clause.literals[clause.watch1];
-      }
-      if (value_of(other_watch) == TRUE) {
-        i++;
-        continue; // clause is already satisfied; do nothing
-      }
-
-      bool changed = false;
-      int watch1 = clause.literals[clause.watch1];
-      int watch2 = clause.literals[clause.watch2];
-
-      for (int j = 0; j < clause.literals.size(); j++) {
-        int lit = clause.literals[j];
-        if (lit == watch1 || lit == watch2) {
-          continue;
-        }
-        if (value_of(lit) != FALSE) {
-          changed = true;
-          if (watch_num == 1)
-            clause.watch1 = j;
-          else
-            clause.watch2 = j;
-          watchers[get_literal_index(lit)].push_back(&clause);
-          watchers[index][i] = watchers[index].back();
-          watchers[index].pop_back();
-          break;
-        }
-      }
-
-      if (changed == true) {
-        continue;
-      } // found another non-false literal to watch; do nothing
-
-      if (value_of(other_watch) == FALSE) {
-        conflict_clause = &clause;
-        if (verbose) {
-          std::cout << "conflict! conflict clause: [";
-          for (int literal : conflict_clause->literals) {
-            std::cout << literal << ", ";
-          }
-          std::cout << "]" << std::endl;
+const long long walker_round_effort =
+    100000000; // ticks a local search thread spends before starting again
+               // from its best assignment
+
+Result solve_portfolio(Solver &solver, int num_threads, int num_walkers,
+                       bool verbose) { // run diversified copies of the
+                                       // preprocessed solver in parallel,
+                                       // alongside local search threads. the
+                                       // first to finish gives the answer
+  Portfolio portfolio(num_threads);
+  std::vector<Solver> solvers(num_threads, solver);
+  std::vector<Result> results(num_threads, RESULT_UNKNOWN);
+  std::vector<std::thread> threads;
+  Walker prototype;
+  if (num_walkers > 0)
+    solver.fill_walker(prototype);
+  std::vector<Walker> walkers(num_walkers, prototype);
+  std::vector<std::vector<char>> assignments(num_walkers);
+  for (int w = 0; w < num_walkers; w++) {
+    assignments[w].assign(solver.num_vars + 1, solver.initial_phase == TRUE);
+    threads.emplace_back([&, w] {
+      uint64_t seed = 0x9e3779b97f4a7c15ull * (w + 1);
+      while (!portfolio.stop.load(std::memory_order_relaxed)) {
+        if (walkers[w].walk(assignments[w], walker_round_effort, seed++,
+                            &portfolio.stop) == 0) {
+          int none = -1;
+          portfolio.winner.compare_exchange_strong(none, num_threads + w);
+          portfolio.stop.store(true, std::memory_order_relaxed);
         }
-        return false; // all literals are false, conflict found; return false
-      } else {
-        trail.push_back(other_watch); // all literals but one are false;
-                                      // propagate the new unit clause
-        assignments[std::abs(other_watch)] =
-            other_watch > 0 ? TRUE : FALSE; // a new unit is being propagated,
-                                            // so we need to assign it
-        if (verbose)
-          std::cout << "assigning " << std::abs(other_watch) << " to "
-                    << (other_watch > 0 ? "TRUE" : "FALSE") << std::endl;
-        last_assignments[std::abs(other_watch)] =
-            other_watch > 0 ? TRUE : FALSE;
-        decision_levels[std::abs(other_watch)] = trail_decisions.size() - 1;
-        reasons[std::abs(other_watch)] = &clause;
-        assigned_vars++;
-        i++;
       }
-    }
-    trail_head++;
+    });
   }
-  return true;
-}
-
-void decide() { // decide the value of one variable, adding it to the trail
-  int highest_activity = 0;
-  int var;
-  for (int i = 1; i < activity.size(); i++) {
-    if (assignments[i] !=
-        UNASSIGNED) { // if a variable has already been assigned,
-      continue;       // we cannot "decide" its value
-    }
-
-    if (activity[i] > highest_activity) {
-      highest_activity = activity[i];
-      var = i;
-    }
-  }
-
-  trail_decisions.push_back(trail.size());
-  int literal =
-      last_assignments[var] == TRUE
-          ? var
-          : -var; // default to false if the variable hasnt been assigned yet
-  trail.push_back(literal);
-  assignments[var] = last_assignments[var];
-  decision_levels[var] = trail_decisions.size() - 1;
-  assigned_vars++;
-
-  if (verbose)
-    std::cout << "deciding " << literal << "..." << std::endl;
-}
-
-std::vector<int> analyse() { // analyse the conflict and add a learned clause
-                             // that "explains" the conflict
-  int decision_level = trail_decisions.size() - 1;
-  int current_level_count =
-      0; // number of variables in the learned clause that are in the current
-         // decision level. once this hits 1, we have found the first UIP, so we
-         // stop
-
-  conflict_clause->activity += clause_activity_inc;
-
-  std::vector<int> learned_clause = conflict_clause->literals;
-  std::vector<bool> seen;
-  seen.resize(2 * num_vars);
-  std::fill(seen.begin(), seen.end(), false);
-
-  std::vector<int> new_clause;
-  new_clause.reserve(learned_clause.size());
-
-  for (int i = 0; i < learned_clause.size(); i++) {
-    if (seen[get_literal_index(learned_clause[i])] == false) {
-      seen[get_literal_index(learned_clause[i])] = true;
-      new_clause.push_back(learned_clause[i]);
-      if (decision_levels[std::abs(learned_clause[i])] == decision_level)
-        current_level_count++;
-    }
-  }
-
-  learned_clause.swap(new_clause);
-
-  for (int i = trail.size() - 1; i >= 0;
-       i--) { // loop backwards through the trail, performing resolution on the
-              // learned clause on each iteration. essentially, we're replacing
-              // each instance of the literal we find in the trail with the
-              // (unseen) literals in its reason clause
-    if (current_level_count == 1) {
-      break;
-    }
-    int index =
-        std::find(learned_clause.begin(), learned_clause.end(), -trail[i]) -
-        learned_clause.begin();
-    if (index !=
-        learned_clause
-            .size()) { // std::find returns vector.size() if item not found
-
-      Clause *reason_clause_ptr = reasons[std::abs(trail[i])];
-      reason_clause_ptr->activity += clause_activity_inc;
-      std::vector<int> reason_clause = reason_clause_ptr->literals;
-      if (reason_clause.empty()) // decision literals have no reason clause, so
-                                 // we can skip them
-        continue;
-      for (int literal : reason_clause) {
-        if (seen[get_literal_index(literal)] == false && literal != trail[i]) {
-          seen[get_literal_index(literal)] = true;
-          learned_clause.push_back(literal);
-          if (decision_levels[std::abs(literal)] == decision_level) {
-            current_level_count++;
-          }
-        }
-      }
-
-      if (decision_levels[std::abs(learned_clause[index])] == decision_level) {
-        current_level_count--;
+  for (int i = 0; i < num_threads; i++) {
+    solvers[i].join(portfolio, i);
+    if (i > 0)
+      solvers[i].progress_interval = 0; // only the first solver reports
+    threads.emplace_back([&, i] {
+      results[i] = solve(solvers[i], verbose && i == 0); // the trace is
+                                                         // only written by
+                                                         // the first solver
+      if (results[i] != RESULT_UNKNOWN) {
+        int none = -1;
+        portfolio.winner.compare_exchange_strong(none, i);
+        portfolio.stop.store(true, std::memory_order_relaxed);
       }
-      learned_clause.erase(learned_clause.begin() + index);
-    }
+    });
   }
-
-  for (int literal : learned_clause) {
-    activity[std::abs(literal)] += activity_inc;
-  }
-
-  for (int i = 0; i < activity.size(); i++) {
-    activity[i] *= activity_decay;
+  for (std::thread &thread : threads) {
+    thread.join();
   }
-
-  for (Clause *ptr : learned_clauses) {
-    ptr->activity *= clause_activity_decay;
+  int winner = portfolio.winner.load();
+  solver = std::move(solvers[winner < num_threads ? winner : 0]); // for its
+                                                                  // model and
+                                                                  // statistics
+  solver.order_heap.activity = &solver.activity;
+  solver.portfolio = nullptr;
+  if (winner < num_threads)
+    return results[winner];
+  const std::vector<char> &assignment = assignments[winner - num_threads];
+  solver.model.resize(solver.num_vars + 1);
+  for (int var = 1; var <= solver.num_vars; var++) {
+    solver.model[var] = assignment[var] ? TRUE : FALSE;
   }
-
-  return learned_clause;
+  solver.restore_eliminated(); // the local search only saw the clauses left
+                               // by preprocessing
+  return RESULT_SAT;
 }
 
-void reduce() { // remove low activity learned clauses
-  std::sort(learned_clauses.begin(), learned_clauses.end(),
-            [](Clause *ptr1, Clause *ptr2) {
-              return (ptr1->activity < ptr2->activity);
-            }); // sort clauses by activity
-
-  std::vector<Clause *> clauses_to_remove; // vector containing clause pointers
-                                           // so the memory can be freed later
-
-  for (int i = 0; i < learned_clauses.size() / 2;
-       i++) { // remove half of the learned clauses with the lowest activity
-              // values
-    if (reasons[std::abs(learned_clauses[i]->literals[0])] !=
-        learned_clauses[i]) { // only remove a clause if it is not currently
-                              // implying the value of a literal
-      learned_clauses[i]->toRemove = true;
-      clauses_to_remove.push_back(learned_clauses[i]);
-    }
+const int model_line_width = 78; // v lines are wrapped before this column
+
+char *write_number(char *out, int number) { // format a number in DIMACS
+  char digits[12];
+  int n = 0;
+  unsigned magnitude = number < 0 ? -(unsigned)number : number;
+  do {
+    digits[n++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (number < 0)
+    *out++ = '-';
+  while (n > 0) {
+    *out++ = digits[--n];
   }
+  return out;
+}
 
-  int old_size = learned_clauses.size();
-
-  for (Clause *c :
-       learned_clauses) { // remove learned clauses marked with toRemove in the
-                          // previous loop from the watcher list
-    if (c->toRemove) {
-      for (int index : {c->watch1, c->watch2}) {
-        int lit = get_literal_index(c->literals[index]);
-        watchers[lit].erase(
-            std::remove(watchers[lit].begin(), watchers[lit].end(), c),
-            watchers[lit].end());
+std::string format_result(Result result, const std::vector<Value> &model,
+                          int num_vars) { // the answer in the SAT competition
+                                          // format, with the model as v lines
+  const char *status = result == RESULT_SAT     ? "s SATISFIABLE\n"
+                       : result == RESULT_UNSAT ? "s UNSATISFIABLE\n"
+                                                : "s UNKNOWN\n";
+  size_t status_size = strlen(status);
+  std::string buffer(status_size +
+                         (result == RESULT_SAT ? 14 * (num_vars + 1) : 0),
+                     '\0');
+  char *out = &buffer[0];
+  memcpy(out, status, status_size);
+  out += status_size;
+  if (result == RESULT_SAT) {
+    char *line = out; // start of the current v line
+    *out++ = 'v';
+    for (int var = 1; var <= num_vars + 1; var++) {
+      int literal = var > num_vars ? 0 : model[var] == TRUE ? var : -var;
+      char number[12];
+      int size = write_number(number, literal) - number;
+      if (out - line + 1 + size > model_line_width) {
+        *out++ = '\n';
+        line = out;
+        *out++ = 'v';
       }
+      *out++ = ' ';
+      memcpy(out, number, size);
+      out += size;
     }
+    *out++ = '\n';
   }
-
-  // remove clauses marked with toRemove from the learned_clauses and clauses
-  // lists
-
-  learned_clauses.erase(std::remove_if(learned_clauses.begin(),
-                                       learned_clauses.end(),
-                                       [](Clause *c) { return c->toRemove; }),
-                        learned_clauses.end());
-
-  clauses.erase(std::remove_if(clauses.begin(), clauses.end(),
-                               [](Clause *c) {
-                                 bool remove = c->toRemove;
-                                 return remove;
-                               }),
-                clauses.end());
-
-  int new_size = learned_clauses.size();
-
-  for (Clause *ptr : clauses_to_remove) { // free memory of removed clauses
-    delete ptr;
-  }
-
-  if (verbose)
-    std::cout << "removed " << old_size - new_size << " clauses" << std::endl;
+  buffer.resize(out - &buffer[0]);
+  return buffer;
 }
 
-void restart() {
-  if (verbose)
-    std::cout << "reached " << num_conflicts << " conflicts! restarting..."
-              << std::endl;
-
-  for (int i = trail.size() - 1; i >= 0; i--) { // unassign every variable
-    int literal = trail[i];
-    int variable = std::abs(literal);
-    assignments[variable] = UNASSIGNED;
-    assigned_vars--;
-    decision_levels[variable] = -1;
-    reasons[variable] = nullptr;
-    trail.pop_back();
+void write_result(Result result, const std::vector<Value> &model,
+                  int num_vars) { // write the answer with a single call
+  std::string buffer = format_result(result, model, num_vars);
+  fflush(stdout); // anything printed before, such as the statistics, comes
+                  // first
+  for (const char *pos = buffer.data(), *end = pos + buffer.size();
+       pos < end;) {
+    ssize_t written = write(STDOUT_FILENO, pos, end - pos);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      break;
+    pos += written;
   }
-
-  max_conflicts *= 1.5; // geometric restart strategy - increase number of
-                        // conflicts required for a restart with each restart
-  if (verbose)
-    std::cout << "increasing restart threshold to " << max_conflicts
-              << std::endl;
 }
 
-void backjump(
-    std::vector<int> learned_clause) { // after a conflict, jump back to the
-                                       // decision that caused it
+const char *const usage =
+    "usage: fieldSAT [OPTIONS] [FILE]\n"
+    "solves the DIMACS CNF formula in FILE, or on stdin if none is given\n"
+    "\n"
+    "  -t N                 use N threads: a portfolio of N solvers, or, if\n"
+    "                       the formula splits into independent components,\n"
+    "                       N components solved at a time by one solver each\n"
+    "  --walkers=N          run N local search threads alongside the search\n"
+    "  --restart=POLICY     glucose (the default), luby or geometric\n"
+    "  --no-preprocess      skip preprocessing\n"
+    "  --no-gauss           skip Gauss-Jordan elimination of XOR constraints\n"
+    "  --no-walk            skip the local search used for rephasing\n"
+    "  --no-components      do not split the formula into components\n"
+    "  --proof FILE         write a binary DRAT proof of an UNSAT answer\n"
+    "  --verify             check the model against the input clauses\n"
+    "  --cache=DIR          look results up in DIR, and store them there\n"
+    "  --save-state=FILE    save the search state once it is over\n"
+    "  --load-state=FILE    start the search from a saved state\n"
+    "  --coordinate=PORT    split into cubes and serve them to workers\n"
+    "  --cube-depth=N       number of decisions in each cube (10)\n"
+    "  --work=HOST:PORT     solve cubes for a coordinator\n"
+    "  --serve[=PATH]       solve a stream of jobs from stdin, or from a\n"
+    "                       unix socket at PATH (see the README)\n"
+    "  --stats[=json]       print statistics at the end\n"
+    "  --progress[=N]       print a progress line every N seconds (5)\n"
+    "  -v                   trace the search\n"
+    "  --trace=EVENTS       only trace the events in a comma separated list\n"
+    "  --trace-level=N      1 leaves out propagate and assign events\n"
+    "  -h, --help           print this help\n";
 
-  int uip = 0; // after backjumping, the UIP (which is the
-               // last element) will be propagated
-  int uip_index = -1;
-  int highest_decision_level = 0;
-  for (int i = 0; i < learned_clause.size(); i++) {
-    int literal = learned_clause[i];
-    int level = decision_levels[std::abs(literal)];
-    if (level != trail_decisions.size() - 1) {
-      if (level > highest_decision_level) {
-        highest_decision_level = level;
+int main(int argc, char *argv[]) {
+  Solver solver;
+  const char *path = nullptr; // input file, or stdin if none is given
+  bool verbose = false;
+  int num_threads = 1;
+  bool threads_given = false; // whether -t was given, for --serve
+  int num_walkers = 0;        // local search threads next to the solvers
+  int coordinator_port = 0;   // split into cubes and serve them on this port
+  int cube_depth = 10;        // number of decisions in each cube
+  const char *coordinator = nullptr; // solve cubes from this host:port
+  bool split = true; // solve independent parts of the formula separately
+  bool stats = false, stats_json = false;
+  const char *proof_path = nullptr; // where the DRAT proof is written
+  const char *cache_directory = nullptr; // where results are looked up and
+                                         // stored, by formula hash
+  const char *save_path = nullptr; // where the search state is saved
+  const char *load_path = nullptr; // where it is loaded from
+  bool serving = false;              // solve a stream of jobs, see server.h
+  const char *socket_path = nullptr; // where they come from, or stdin
+  std::vector<int> original_clauses; // input clauses, kept with --verify
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      std::cout << usage;
+      return 0;
+    } else if (strcmp(argv[i], "-v") == 0) {
+      verbose = true;
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      num_threads = std::max(1, atoi(argv[++i]));
+      threads_given = true;
+    } else if (strncmp(argv[i], "--walkers=", 10) == 0) {
+      num_walkers = std::max(0, atoi(argv[i] + 10));
+    } else if (strcmp(argv[i], "--no-walk") == 0) {
+      solver.walk_enabled = false;
+    } else if (strcmp(argv[i], "--restart=geometric") == 0) {
+      solver.use_restart_policy(RESTART_GEOMETRIC);
+    } else if (strcmp(argv[i], "--restart=luby") == 0) {
+      solver.use_restart_policy(RESTART_LUBY);
+    } else if (strcmp(argv[i], "--restart=glucose") == 0) {
+      solver.use_restart_policy(RESTART_GLUCOSE);
+    } else if (strncmp(argv[i], "--coordinate=", 13) == 0) {
+      coordinator_port = atoi(argv[i] + 13);
+    } else if (strncmp(argv[i], "--cube-depth=", 13) == 0) {
+      cube_depth = std::max(1, atoi(argv[i] + 13));
+    } else if (strncmp(argv[i], "--work=", 7) == 0) {
+      coordinator = argv[i] + 7;
+    } else if (strncmp(argv[i], "--proof=", 8) == 0) {
+      proof_path = argv[i] + 8;
+    } else if (strcmp(argv[i], "--proof") == 0 && i + 1 < argc) {
+      proof_path = argv[++i];
+    } else if (strncmp(argv[i], "--cache=", 8) == 0) {
+      cache_directory = argv[i] + 8;
+    } else if (strncmp(argv[i], "--save-state=", 13) == 0) {
+      save_path = argv[i] + 13;
+    } else if (strncmp(argv[i], "--load-state=", 13) == 0) {
+      load_path = argv[i] + 13;
+    } else if (strcmp(argv[i], "--serve") == 0) {
+      serving = true;
+    } else if (strncmp(argv[i], "--serve=", 8) == 0) {
+      serving = true;
+      socket_path = argv[i] + 8;
+    } else if (strcmp(argv[i], "--verify") == 0) {
+      solver.original_clauses = &original_clauses;
+    } else if (strcmp(argv[i], "--stats") == 0) {
+      stats = true;
+    } else if (strcmp(argv[i], "--stats=json") == 0) {
+      stats_json = true;
+    } else if (strcmp(argv[i], "--progress") == 0) {
+      solver.progress_interval = 5;
+    } else if (strncmp(argv[i], "--progress=", 11) == 0) {
+      solver.progress_interval = atof(argv[i] + 11);
+    } else if (strcmp(argv[i], "--no-gauss") == 0) {
+      solver.gauss_enabled = false;
+    } else if (strcmp(argv[i], "--no-components") == 0) {
+      split = false;
+    } else if (strcmp(argv[i], "--no-preprocess") == 0) {
+      solver.preprocess_enabled = false;
+    } else if (strncmp(argv[i], "--trace-level=", 14) == 0) {
+      verbose = true;
+      trace.level = atoi(argv[i] + 14);
+    } else if (strncmp(argv[i], "--trace=", 8) == 0) {
+      verbose = true; // only trace the events in the comma separated list
+      std::fill(trace.events, trace.events + NUM_TRACE_EVENTS, false);
+      std::string list = argv[i] + 8;
+      size_t start = 0;
+      while (start <= list.size()) {
+        size_t end = std::min(list.find(',', start), list.size());
+        std::string name = list.substr(start, end - start);
+        for (int e = 0; e < NUM_TRACE_EVENTS; e++) {
+          if (name == trace_event_names[e])
+            trace.events[e] = true;
+        }
+        start = end + 1;
       }
     } else {
-      uip = literal;
-      uip_index = i;
+      path = argv[i];
     }
   }
-
-  int index = highest_decision_level + 1;
-
-  if (learned_clause.size() == 1)
-    index = 1;
-
-  if (verbose)
-    std::cout << "backjumping to decision level " << index - 1 << "..."
-              << std::endl;
-
-  for (int i = trail.size() - 1; i >= trail_decisions[index]; i--) {
-    int literal = trail[i];
-    int variable = std::abs(literal);
-    assignments[variable] = UNASSIGNED;
-    assigned_vars--;
-    decision_levels[variable] = -1;
-    reasons[variable] = nullptr;
-    trail.pop_back();
-  }
-
-  if (learned_clause.size() != 1) {
-    int temp = learned_clause[0];
-    learned_clause[0] = learned_clause[uip_index];
-    learned_clause[uip_index] =
-        temp; // swap UIP (asserting literal) into position 0 so later, we can
-              // easily check if learned clause is "locked" (i.e. it is a reason
-              // clause for a current assignment, and cannot be deleted)
-    Clause *c = new Clause({learned_clause, 0, 1});
-    clauses.push_back(c);
-    watchers[get_literal_index(learned_clause[0])].push_back(c);
-    watchers[get_literal_index(learned_clause[1])].push_back(c);
-    learned_clauses.push_back(c);
-    trail_decisions.resize(highest_decision_level + 1);
-  } else {
-    Clause *c = new Clause({learned_clause, 0, 0});
-    clauses.push_back(c);
-    watchers[get_literal_index(learned_clause[0])].push_back(c);
-    learned_clauses.push_back(c);
-    trail_decisions.resize(1);
-  }
-  trail.push_back(uip);
-  trail_head = trail.size() - 1;
-  reasons[std::abs(uip)] = clauses.back();
-  decision_levels[std::abs(uip)] = highest_decision_level;
-  Value uip_value = uip > 0 ? TRUE : FALSE;
-  assignments[std::abs(uip)] = uip_value;
-  last_assignments[std::abs(uip)] = uip_value;
-  assigned_vars++;
-
-  if (num_conflicts % reduction_threshold == 0) {
-    reduce();
+  if (serving) {
+    if (path || proof_path || coordinator_port || coordinator ||
+        cache_directory || save_path || load_path) {
+      std::cerr << "error: --serve cannot be combined with an input file, "
+                   "--proof, --coordinate, --work, --cache or the state "
+                   "options"
+                << std::endl;
+      return 1;
+    }
+    if (verbose || stats || stats_json || solver.progress_interval > 0 ||
+        solver.original_clauses || num_walkers > 0) {
+      std::cerr << "error: --serve cannot be combined with -v, --trace, "
+                   "--stats, --progress, --verify or --walkers"
+                << std::endl;
+      return 1;
+    }
+    return serve(solver, socket_path,
+                 threads_given ? num_threads
+                               : std::max(1u, std::thread::hardware_concurrency()))
+               ? 0
+               : 1;
   }
-
-  if (num_conflicts >= max_conflicts) {
-    restart();
+  if ((save_path || load_path) && (proof_path || coordinator_port)) {
+    std::cerr << "error: --save-state and --load-state cannot be combined "
+                 "with --proof or --coordinate"
+              << std::endl;
+    return 1;
   }
-}
-
-void parse() { // parse the DIMACS CNF input
-  std::string literal;
-
-  while (std::cin >> literal) {
-    if (literal == "c") {
-      std::getline(
-          std::cin,
-          literal); // lines starting with c are comments, so ignore line
-    } else if (literal == "p") {
-      std::string string_num_vars, string_num_clauses;
-
-      std::cin >> literal >> string_num_vars >>
-          string_num_clauses; // after the p is "cnf", which can be ignored,
-                              // then the number of variables and clauses
-
-      num_vars = std::stoi(string_num_vars);
-      num_clauses = std::stoi(string_num_clauses);
-    } else {
-      std::vector<int> clause;
-      std::vector<bool> seen;
-      seen.resize(2 * num_vars);
-      std::fill(seen.begin(), seen.end(), false);
-      while (literal != "0") { // clauses are terminated with 0
-        if (seen[get_literal_index(std::stoi(literal))] == false) {
-          clause.push_back(std::stoi(literal));
-          seen[get_literal_index(std::stoi(literal))] = true;
-        }
-        std::cin >> literal;
-      }
-      Clause *c = new Clause({clause, 0, 0});
-      clauses.push_back(c);
+  ProofWriter proof;
+  if (proof_path) {
+    if (num_threads > 1 || coordinator_port || coordinator) {
+      std::cerr << "error: --proof needs a single solver, so cannot be "
+                   "combined with -t, --coordinate or --work"
+                << std::endl;
+      return 1;
     }
-  }
-}
-
-bool initialise() {                 // initialise any important variables
-  assignments.resize(num_vars + 1); // the assignment vector is 1-indexed
-  std::fill(assignments.begin(), assignments.end(),
-            UNASSIGNED); // all variables start unassigned
-
-  last_assignments.resize(num_vars + 1);
-  std::fill(last_assignments.begin(), last_assignments.end(),
-            FALSE); // last assignment defaults to false (since if a variable
-                    // hasn't been assigned before, we try assigning false to it
-                    // first when deciding its value)
-
-  decision_levels.resize(num_vars + 1);
-  std::fill(decision_levels.begin(), decision_levels.end(), -1);
-
-  reasons.resize(num_vars + 1);
-
-  activity.resize(num_vars + 1);
-  std::fill(activity.begin(), activity.end(), 1);
-
-  watchers.resize(
-      2 * num_vars); // the watchers array is indexed over each literal (i.e.
-                     // positive and negative propositional variables)
-
-  trail_decisions.push_back(
-      0); // the root decision level begins at trail index 0
-
-  for (int i = 0; i < clauses.size(); i++) {
-    if (clauses[i]->literals.size() == 1) {
-      int literal = clauses[i]->literals[0];
-      Value lit_value = literal > 0 ? TRUE : FALSE;
-      if (assignments[std::abs(literal)] == UNASSIGNED) {
-        trail.push_back(literal); // unit clause, so add its literal to the
-                                  // trail to be propagated
-        assignments[std::abs(literal)] = literal > 0 ? TRUE : FALSE;
-        assigned_vars++;
-      } else if (lit_value != assignments[std::abs(literal)]) {
-        return false;
-      }
-    } else {
-      watchers[get_literal_index(clauses[i]->literals[0])].push_back(
-          clauses[i]); // add the first two literals as watched literals to the
-                       // watchers array and struct attributes
-      watchers[get_literal_index(clauses[i]->literals[1])].push_back(
-          clauses[i]);
-      clauses[i]->watch1 = 0;
-      clauses[i]->watch2 = 1;
+    if (!proof.open(proof_path)) {
+      std::cerr << "error: could not open " << proof_path << std::endl;
+      return 1;
     }
+    solver.proof = &proof;
   }
-
-  return true;
-}
-
-bool sat_loop() { // loop that continually propagates variables, analysing
-                  // conflicts or deciding variables when appropriate
-  while (true) {
-    if (propagate()) { // propagate unit clauses. if propagate returns true, no
-                       // conflict was found
-      if (assigned_vars ==
-          num_vars) { // if all variables have been assigned, satisfiable
-        return true;
-      } else {
-        decide();
-      }
-    } else {
-      num_conflicts++;
-      if (trail_decisions.size() - 1 == 0) {
-        return false; // conflict at root decision level means unsat
-      }
-      std::vector<int> learned_clause = analyse();
-      backjump(learned_clause);
-    }
+  solver.parse(path);
+  Result cached = cache_directory && !proof_path && !coordinator
+                      ? cache_lookup(solver, cache_directory)
+                      : RESULT_UNKNOWN; // a proof must still be found
+  if (cached != RESULT_UNKNOWN && verbose && trace.wants(TRACE_PREPROCESS))
+    trace << "found the result in the cache\n";
+  bool simplified = cached != RESULT_UNKNOWN ||
+                    (verbose ? solver.preprocess<VerboseTrace>()
+                             : solver.preprocess<NoTrace>());
+  if (cached == RESULT_UNKNOWN && simplified && load_path &&
+      !load_state(solver, load_path)) {
+    std::cerr << "error: could not read " << load_path << std::endl;
+    return 1;
   }
-}
-
-int main(int argc, char *argv[]) {
-  for (int i = 0; i < argc; i++) {
-    if (strcmp(argv[i], "-v") == 0) {
-      verbose = true;
+  if (coordinator) { // the coordinator reports the answer
+    if (simplified && !work(solver, coordinator)) {
+      std::cerr << "error: could not connect to " << coordinator << std::endl;
+      return 1;
     }
-  }
-  parse();
-  if (!initialise()) { // initialise can return false if it finds two unit
-                       // clauses that contradict each other
-    std::cout << "UNSATISFIABLE" << std::endl;
     return 0;
   }
-  std::cout << (sat_loop() ? "SATISFIABLE" : "UNSATISFIABLE") << std::endl;
+  Components components;
+  bool split_up = cached == RESULT_UNKNOWN && simplified && split &&
+                  !proof_path && !coordinator_port && num_walkers == 0 &&
+                  !save_path && !load_path &&
+                  split_components(solver, components);
+  if (split_up && verbose && trace.wants(TRACE_PREPROCESS))
+    trace << "split the formula into " << components.clauses.size()
+          << " independent parts\n";
+  Result result = cached != RESULT_UNKNOWN ? cached
+                  : !simplified            ? RESULT_UNSAT
+                  : coordinator_port
+                      ? coordinate(solver, coordinator_port, cube_depth)
+                  : split_up
+                      ? solve_components(solver, components, num_threads,
+                                         verbose)
+                  : num_threads == 1 && num_walkers == 0
+                      ? solve(solver, verbose)
+                      : solve_portfolio(solver, num_threads, num_walkers,
+                                        verbose);
+  trace.flush();
+  if (save_path && cached == RESULT_UNKNOWN && simplified &&
+      !save_state(solver, save_path))
+    std::cerr << "error: could not write " << save_path << std::endl;
+  if (proof_path) {
+    if (result == RESULT_UNSAT)
+      proof.add(nullptr, 0); // the empty clause
+    proof.close();
+    if (proof.failed)
+      std::cerr << "error: could not write " << proof_path << std::endl;
+  }
+  if (stats)
+    solver.print_stats();
+  if (stats_json)
+    solver.print_stats_json();
+  if (result == RESULT_SAT && solver.original_clauses &&
+      !verify_model(original_clauses, solver.model)) {
+    std::cerr << "error: the model does not satisfy the input" << std::endl;
+    write_result(RESULT_UNKNOWN, solver.model, solver.num_vars);
+    return 1;
+  }
+  if (cache_directory && cached == RESULT_UNKNOWN && !coordinator_port &&
+      result != RESULT_UNKNOWN)
+    cache_store(solver, cache_directory, result);
+  write_result(result, solver.model, solver.num_vars);
   return 0;
 }
@@ -0,0 +1,238 @@
+/* gauss.cpp - Gauss-Jordan elimination over XOR constraints
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "solver.h"
+
+void XorMatrix::add_row(const std::vector<int> &vars, bool parity) {
+  bits.resize(bits.size() + words);
+  uint64_t *new_row = row(num_rows());
+  for (int var : vars) {
+    int column = var_columns[var];
+    new_row[column >> 6] ^= 1ull << (column & 63);
+  }
+  rhs.push_back(parity);
+}
+
+void add_to(uint64_t *to, const uint64_t *from, int words) { // a plain loop
+                                                             // over words,
+                                                             // which the
+                                                             // compiler
+                                                             // vectorises
+  for (int w = 0; w < words; w++) {
+    to[w] ^= from[w];
+  }
+}
+
+bool XorMatrix::eliminate() {
+  int rank = 0;
+  basics.clear();
+  basic_rows.assign(num_columns, -1);
+  for (int column = 0; column < num_columns && rank < num_rows(); column++) {
+    int r = rank;
+    while (r < num_rows() && !test(row(r), column)) {
+      r++;
+    }
+    if (r == num_rows())
+      continue; // every row with this column already has a basic column
+    std::swap_ranges(row(r), row(r) + words, row(rank));
+    std::swap(rhs[r], rhs[rank]);
+    for (int other = 0; other < num_rows(); other++) {
+      if (other != rank && test(row(other), column)) {
+        add_to(row(other), row(rank), words);
+        rhs[other] ^= rhs[rank];
+      }
+    }
+    basics.push_back(column);
+    basic_rows[column] = rank++;
+  }
+  for (int r = rank; r < num_rows(); r++) {
+    if (rhs[r])
+      return false; // the sum of some rows is 0 = 1
+  }
+  bits.resize((size_t)rank * words);
+  rhs.resize(rank);
+
+  assigned.assign(words, 0);
+  true_values.assign(words, 0);
+  dirty.assign(rank, false);
+  dirty_rows.clear();
+  for (int r = 0; r < rank; r++) {
+    mark_dirty(r); // rows of one column are implied straight away
+  }
+  return true;
+}
+
+void XorMatrix::mark_dirty(int r) {
+  if (!dirty[r]) {
+    dirty[r] = true;
+    dirty_rows.push_back(r);
+  }
+}
+
+void XorMatrix::pivot(int r, int column) {
+  for (int other = 0; other < num_rows(); other++) {
+    if (other != r && test(row(other), column)) {
+      add_to(row(other), row(r), words);
+      rhs[other] ^= rhs[r];
+      mark_dirty(other);
+    }
+  }
+  basic_rows[basics[r]] = -1;
+  basics[r] = column;
+  basic_rows[column] = r;
+}
+
+void XorMatrix::assign(int column, bool value) {
+  uint64_t mask = 1ull << (column & 63);
+  int word = column >> 6;
+  assigned[word] |= mask;
+  if (value)
+    true_values[word] |= mask;
+  for (int r = 0; r < num_rows(); r++) {
+    if (row(r)[word] & mask)
+      mark_dirty(r);
+  }
+}
+
+void XorMatrix::unassign(int column) {
+  uint64_t mask = ~(1ull << (column & 63));
+  assigned[column >> 6] &= mask;
+  true_values[column >> 6] &= mask;
+}
+
+int XorMatrix::check(int r, int &column) {
+  const uint64_t *bits = row(r);
+  int count = 0;
+  column = -1;
+  for (int w = 0; w < words && count < 2; w++) {
+    uint64_t open = bits[w] & ~assigned[w];
+    if (open != 0) {
+      if (column < 0)
+        column = w * 64 + __builtin_ctzll(open);
+      count += __builtin_popcountll(open);
+    }
+  }
+  if (count > 0 && test(assigned.data(), basics[r]))
+    pivot(r, column); // the basic column was assigned while the row had no
+                      // other unassigned column, and the row has gained
+                      // some since, by a pivot or a backtrack
+  if (count > 1)
+    return -1;
+  int parity = rhs[r];
+  for (int w = 0; w < words; w++) {
+    parity ^= __builtin_popcountll(bits[w] & true_values[w]) & 1;
+  }
+  return parity;
+}
+
+bool find_xors(ClauseArena &arena, const std::vector<CRef> &clauses,
+               int num_vars, XorMatrix &matrix) {
+  struct Candidate {
+    uint64_t hash; // of the variables, regardless of order and signs
+    CRef ref;
+  };
+  std::vector<Candidate> candidates;
+  for (CRef ref : clauses) {
+    Clause &clause = arena[ref];
+    if (clause.learned || clause.size < xor_min_size ||
+        clause.size > xor_max_size)
+      continue;
+    uint64_t hash = clause.size;
+    for (int literal : clause) {
+      hash += mix64(var_of(literal));
+    }
+    candidates.push_back({hash, ref});
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.hash < b.hash;
+            });
+
+  std::vector<std::vector<int>> xors; // variables of each XOR found
+  std::vector<char> parities;
+  std::vector<int> vars, literals;
+  for (size_t start = 0, end; start < candidates.size(); start = end) {
+    end = start + 1;
+    while (end < candidates.size() &&
+           candidates[end].hash == candidates[start].hash)
+      end++;
+    int size = arena[candidates[start].ref].size;
+    if (end - start < (1u << (size - 1)))
+      continue; // too few clauses for an XOR of this size
+    uint64_t patterns = 0; // bit n is set if there is a clause in which the
+                           // variables with a negative literal are the bits
+                           // of n, in order of variable
+    vars.clear();
+    for (size_t i = start; i < end; i++) {
+      Clause &clause = arena[candidates[i].ref];
+      literals.assign(clause.begin(), clause.end());
+      std::sort(literals.begin(), literals.end());
+      if (vars.empty()) {
+        for (int literal : literals) {
+          vars.push_back(var_of(literal));
+        }
+      }
+      int pattern = 0;
+      bool same = literals.size() == vars.size();
+      for (int k = 0; k < literals.size() && same; k++) {
+        same = var_of(literals[k]) == vars[k];
+        pattern |= is_negative(literals[k]) << k;
+      }
+      if (same) // clauses whose variables only collide in the hash are
+                // left out
+        patterns |= 1ull << pattern;
+    }
+    uint64_t even = 0; // patterns with an even number of negative literals
+    for (int pattern = 0; pattern < (1 << size); pattern++) {
+      if (__builtin_popcount(pattern) % 2 == 0)
+        even |= 1ull << pattern;
+    }
+    uint64_t odd = ~even & (size == 6 ? ~0ull : (1ull << (1 << size)) - 1);
+    for (int negated = 0; negated < 2; negated++) {
+      uint64_t needed = negated ? odd : even;
+      if ((patterns & needed) == needed) { // each clause rules out the
+                                           // assignment making all of its
+                                           // literals false, so together
+                                           // they rule out one parity
+        xors.push_back(vars);
+        parities.push_back(!negated);
+      }
+    }
+  }
+
+  matrix = XorMatrix();
+  if (xors.empty())
+    return true;
+  matrix.var_columns.assign(num_vars + 1, -1);
+  for (const std::vector<int> &xor_vars : xors) {
+    for (int var : xor_vars) {
+      if (matrix.var_columns[var] < 0) {
+        matrix.var_columns[var] = matrix.column_vars.size();
+        matrix.column_vars.push_back(var);
+      }
+    }
+  }
+  matrix.num_columns = matrix.column_vars.size();
+  if (matrix.num_columns > xor_max_columns) {
+    matrix = XorMatrix();
+    return true;
+  }
+  matrix.words = (matrix.num_columns + 63) / 64;
+  for (int i = 0; i < xors.size(); i++) {
+    matrix.add_row(xors[i], parities[i]);
+  }
+  return matrix.eliminate();
+}
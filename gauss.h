@@ -0,0 +1,84 @@
+/* gauss.h - Gauss-Jordan elimination over XOR constraints
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_GAUSS_H
+#define FIELDSAT_GAUSS_H
+
+#include <cstdint>
+#include <vector>
+
+const int xor_min_size = 3; // XOR constraints are recovered from clauses of
+const int xor_max_size = 6; // these sizes. one of n variables takes 2^(n-1)
+                            // clauses, all of which must be present
+const int xor_max_columns =
+    4096; // formulas whose XOR constraints have more variables than this are
+          // left to the clauses alone, since the matrix would be too large
+          // to keep eliminated
+
+struct XorMatrix { // a system of XOR constraints over GF(2), one per row,
+                   // kept in reduced row echelon form: each row has a basic
+                   // column that occurs in no other row. rows are pivoted so
+                   // that the basic column stays unassigned while the row has
+                   // any unassigned column. a row with a single unassigned
+                   // column then implies its value, a row with none is in
+                   // conflict if its parity is wrong, and no sum of rows
+                   // implies anything the rows do not imply by themselves
+  int num_columns = 0;
+  int words = 0;               // 64-bit words in each row
+  std::vector<int> column_vars; // variable of each column
+  std::vector<int> var_columns; // column of each variable, or -1
+  std::vector<uint64_t> bits;   // the rows, words apart, one bit per column
+  std::vector<char> rhs;        // the parity each row must have
+  std::vector<int> basics;      // basic column of each row
+  std::vector<int> basic_rows;  // row each column is basic in, or -1
+
+  std::vector<uint64_t> assigned;    // columns the solver has assigned, as
+                                     // far as assign() has been told
+  std::vector<uint64_t> true_values; // those of them that are true
+  std::vector<int> dirty_rows; // rows with a column assigned since they were
+                               // last checked
+  std::vector<char> dirty;     // whether each row is in dirty_rows
+
+  bool empty() const { return rhs.empty(); }
+  int num_rows() const { return rhs.size(); }
+  uint64_t *row(int r) { return &bits[(size_t)r * words]; }
+  int column_of(int var) const {
+    return var < var_columns.size() ? var_columns[var] : -1;
+  }
+  static bool test(const uint64_t *set, int column) {
+    return (set[column >> 6] >> (column & 63)) & 1;
+  }
+
+  void add_row(const std::vector<int> &vars,
+               bool parity); // add the constraint that the variables sum to
+                             // parity. their columns must exist already
+  bool eliminate(); // bring the rows into reduced row echelon form, dropping
+                    // the ones that turn out to be sums of others. returns
+                    // false if the system has no solution
+  void mark_dirty(int r);
+  void pivot(int r, int column); // make column the basic column of row r,
+                                 // adding the row to every other row that
+                                 // contains it
+  void assign(int column, bool value); // note that the solver assigned the
+                                       // variable of a column
+  void unassign(int column);           // and that it was unassigned again
+  int check(int r, int &column); // -1 if row r has at least two unassigned
+                                 // columns. otherwise the parity still needed
+                                 // from its unassigned column, which is
+                                 // left in column, or -1 if there is none
+};
+
+#endif
@@ -0,0 +1,87 @@
+/* ipasir.cpp - the IPASIR interface of the fieldSAT solver
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+#include "ipasir.h"
+#include "solver.h"
+
+struct IncrementalSolver { // a solver along with the clause and assumptions
+                           // being built through the interface
+  Solver solver;
+  std::vector<int> clause;
+  std::vector<int> assumptions;
+
+  IncrementalSolver() {
+    solver.preprocess_enabled = false; // eliminated variables could appear
+                                       // in clauses added later
+  }
+};
+
+static IncrementalSolver *cast(void *solver) {
+  return static_cast<IncrementalSolver *>(solver);
+}
+
+extern "C" {
+
+const char *ipasir_signature() { return "fieldSAT"; }
+
+void *ipasir_init() { return new IncrementalSolver; }
+
+void ipasir_release(void *solver) { delete cast(solver); }
+
+void ipasir_add(void *solver, int32_t lit_or_zero) {
+  IncrementalSolver *s = cast(solver);
+  if (lit_or_zero != 0) {
+    s->clause.push_back(lit_or_zero);
+    return;
+  }
+  s->solver.add_clause(s->clause);
+  s->clause.clear();
+}
+
+void ipasir_assume(void *solver, int32_t lit) {
+  cast(solver)->assumptions.push_back(lit);
+}
+
+int ipasir_solve(void *solver) {
+  IncrementalSolver *s = cast(solver);
+  Result result = s->solver.solve(s->assumptions);
+  s->assumptions.clear();
+  return result;
+}
+
+int32_t ipasir_val(void *solver, int32_t lit) {
+  Value value = cast(solver)->solver.value(lit);
+  return value == TRUE ? lit : value == FALSE ? -lit : 0;
+}
+
+int ipasir_failed(void *solver, int32_t lit) {
+  return cast(solver)->solver.failed(lit);
+}
+
+void ipasir_set_terminate(void *solver, void *data,
+                          int (*terminate)(void *data)) {
+  Solver &s = cast(solver)->solver;
+  s.terminate = terminate;
+  s.terminate_data = data;
+}
+
+void ipasir_set_learn(void *solver, void *data, int max_length,
+                      void (*learn)(void *data, int32_t *clause)) {
+  Solver &s = cast(solver)->solver;
+  s.learn = learn;
+  s.learn_data = data;
+  s.learn_max_size = max_length;
+}
+}
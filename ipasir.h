@@ -0,0 +1,59 @@
+/* ipasir.h - the IPASIR interface for incremental SAT solvers
+
+This is the standard interface used by the SAT competition's incremental
+track, as implemented by fieldSAT in ipasir.cpp. Literals are DIMACS integers:
+variable v is v, and its negation is -v. */
+
+#ifndef IPASIR_H
+#define IPASIR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// name and version of the solver
+const char *ipasir_signature();
+
+// create a new solver, which is empty and in the INPUT state
+void *ipasir_init();
+
+// destroy a solver, releasing all of its memory
+void ipasir_release(void *solver);
+
+// add the given literal to the clause being built, or finish the clause if
+// the literal is zero. clauses stay in the solver for every later call
+void ipasir_add(void *solver, int32_t lit_or_zero);
+
+// assume the given literal for the next call to ipasir_solve() only
+void ipasir_assume(void *solver, int32_t lit);
+
+// solve the formula under the current assumptions, which are then cleared.
+// returns 10 if satisfiable, 20 if unsatisfiable, or 0 if interrupted by the
+// terminate callback
+int ipasir_solve(void *solver);
+
+// after a satisfiable result: lit if it is true in the model, -lit if it is
+// false, or 0 if either value will do
+int32_t ipasir_val(void *solver, int32_t lit);
+
+// after an unsatisfiable result: 1 if the assumption lit was used to prove
+// the formula unsatisfiable, otherwise 0
+int ipasir_failed(void *solver, int32_t lit);
+
+// set a callback polled during the search, which stops it by returning
+// nonzero
+void ipasir_set_terminate(void *solver, void *data,
+                          int (*terminate)(void *data));
+
+// set a callback given every learned clause of up to max_length literals, as
+// a zero terminated array that is only valid during the call
+void ipasir_set_learn(void *solver, void *data, int max_length,
+                      void (*learn)(void *data, int32_t *clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
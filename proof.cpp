@@ -0,0 +1,78 @@
+/* proof.cpp - binary DRAT proof output
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "proof.h"
+
+void write_blocks(ProofWriter *proof) { // body of the writer thread
+  std::unique_lock<std::mutex> lock(proof->mutex);
+  while (true) {
+    proof->filled.wait(lock, [proof] {
+      return !proof->queue.empty() || proof->closing;
+    });
+    if (proof->queue.empty())
+      return; // closing, and everything has been written
+    std::vector<char> block = std::move(proof->queue.front());
+    proof->queue.pop_front();
+    lock.unlock();
+    if (fwrite(block.data(), 1, block.size(), proof->file) != block.size())
+      proof->failed = true;
+    lock.lock();
+    proof->spare.push_back(std::move(block));
+    proof->emptied.notify_one();
+  }
+}
+
+bool ProofWriter::open(const char *path) {
+  file = fopen(path, "wb");
+  if (!file)
+    return false;
+  setvbuf(file, nullptr, _IONBF, 0); // blocks are already large
+  block.resize(proof_block_size);
+  writer = std::thread(write_blocks, this);
+  return true;
+}
+
+void ProofWriter::hand_over() {
+  std::unique_lock<std::mutex> lock(mutex);
+  emptied.wait(lock, [this] { return queue.size() < proof_queue_limit; });
+  block.resize(used);
+  queue.push_back(std::move(block));
+  if (spare.empty()) {
+    block = std::vector<char>();
+  } else {
+    block = std::move(spare.back());
+    spare.pop_back();
+  }
+  block.resize(proof_block_size);
+  used = 0;
+  filled.notify_one();
+}
+
+void ProofWriter::close() {
+  if (!file)
+    return;
+  if (used > 0)
+    hand_over();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    closing = true;
+  }
+  filled.notify_one();
+  writer.join();
+  if (fclose(file) != 0)
+    failed = true;
+  file = nullptr;
+}
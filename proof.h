@@ -0,0 +1,84 @@
+/* proof.h - binary DRAT proof output
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_PROOF_H
+#define FIELDSAT_PROOF_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const size_t proof_block_size =
+    1 << 20; // bytes in each block handed over to the writer thread
+const size_t proof_queue_limit =
+    16; // full blocks that may wait to be written before the solver waits
+        // for the writer to catch up
+
+struct ProofWriter { // a DRAT proof in the binary format, written out by a
+                     // thread of its own. the solver fills a block in
+                     // memory, and only synchronises with the writer once a
+                     // block is full.
+                     // in the binary format, each clause is 'a' (added) or
+                     // 'd' (deleted), then its literals, then a zero. a
+                     // literal of variable v is the number 2v (v) or 2v + 1
+                     // (-v), which is exactly the solver's own encoding,
+                     // written 7 bits at a time, least significant first,
+                     // with the top bit of every byte but the last set
+  FILE *file = nullptr;
+  std::vector<char> block; // block being filled, proof_block_size long
+  size_t used = 0;         // bytes of block filled so far
+  std::deque<std::vector<char>> queue; // full blocks, oldest first
+  std::vector<std::vector<char>> spare; // written blocks, to be reused
+  std::mutex mutex;                     // guards queue, spare and closing
+  std::condition_variable filled;       // signalled when a block is queued
+  std::condition_variable emptied;      // signalled when a block is written
+  bool closing = false;
+  bool failed = false; // set by the writer if the file could not be written
+  std::thread writer;
+
+  ~ProofWriter() { close(); }
+
+  bool open(const char *path); // see proof.cpp
+  void close();                // write out everything, and wait for it
+  void hand_over();            // queue the current block for writing
+
+  void write(char kind, const int *literals, int size) {
+    if (used + 5 * size + 2 > proof_block_size) // a literal takes at most 5
+                                                // bytes
+      hand_over();
+    char *out = block.data() + used;
+    *out++ = kind;
+    for (int i = 0; i < size; i++) {
+      unsigned value = literals[i];
+      while (value > 127) {
+        *out++ = (char)(value | 128);
+        value >>= 7;
+      }
+      *out++ = (char)value;
+    }
+    *out++ = 0;
+    used = out - block.data();
+  }
+
+  void add(const int *literals, int size) { write('a', literals, size); }
+  void add(const std::vector<int> &c) { write('a', c.data(), c.size()); }
+  void remove(const int *literals, int size) { write('d', literals, size); }
+};
+
+#endif
@@ -0,0 +1,368 @@
+/* server.cpp - solving a stream of formulas in one process
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "server.h"
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+const int server_queue_per_worker =
+    4; // jobs read ahead of the workers, per worker, before reading waits
+
+struct Client { // a stream jobs are read from and answered on: stdin and
+                // stdout, or a connection to the socket
+  int in_fd = -1, out_fd = -1;
+  bool is_socket = false;
+  std::string input;        // bytes received but not yet taken
+  std::mutex output_mutex;  // answers are written by the workers, one whole
+                            // answer at a time
+
+  ~Client() {
+    if (is_socket)
+      close(in_fd);
+  }
+
+  bool send(const std::string &data) {
+    std::lock_guard<std::mutex> lock(output_mutex);
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = is_socket ? ::send(out_fd, data.data() + sent,
+                                     data.size() - sent,
+                                     MSG_NOSIGNAL) // a closed peer is noticed
+                                                   // by the return value
+                            : write(out_fd, data.data() + sent,
+                                    data.size() - sent);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        return false;
+      sent += n;
+    }
+    return true;
+  }
+
+  bool receive() { // read what has arrived, returning false once closed
+    char buffer[1 << 16];
+    ssize_t n;
+    do {
+      n = read(in_fd, buffer, sizeof(buffer));
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+      return false;
+    input.append(buffer, n);
+    return true;
+  }
+
+  bool next_line(std::string &line) { // wait for the next complete line
+    size_t end;
+    while ((end = input.find('\n')) == std::string::npos) {
+      if (input.size() > 4096 || !receive())
+        return false; // no header is this long
+    }
+    line.assign(input, 0, end);
+    input.erase(0, end + 1);
+    return true;
+  }
+
+  bool next_bytes(std::vector<char> &bytes, size_t size) { // wait for them
+    while (input.size() < size) {
+      if (!receive())
+        return false;
+    }
+    bytes.assign(input.begin(), input.begin() + size);
+    input.erase(0, size);
+    return true;
+  }
+};
+
+struct Job {
+  std::shared_ptr<Client> client; // where the answer goes
+  std::string id;
+  long long max_conflicts = 0;
+  double max_seconds = 0;
+  std::vector<char> text; // the formula, zero terminated
+};
+
+struct JobQueue { // jobs read but not yet taken up by a worker
+  std::deque<Job> jobs;
+  size_t limit = 0;
+  bool closed = false; // set once no more jobs will come
+  std::mutex mutex;
+  std::condition_variable changed;
+
+  bool push(Job &&job) { // returns false once the queue is closed
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return jobs.size() < limit || closed; });
+    if (closed)
+      return false;
+    jobs.push_back(std::move(job));
+    changed.notify_all();
+    return true;
+  }
+
+  bool pop(Job &job) { // returns false once the queue is closed and empty
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !jobs.empty() || closed; });
+    if (jobs.empty())
+      return false;
+    job = std::move(jobs.front());
+    jobs.pop_front();
+    changed.notify_all();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    changed.notify_all();
+  }
+};
+
+std::string answer(const std::string &id, const std::string &output) {
+  return id + " " + std::to_string(output.size()) + "\n" + output;
+}
+
+bool read_formula(Solver &solver, const std::vector<char> &text,
+                  std::string &error) { // add the clauses of a DIMACS
+                                        // formula to an uninitialised solver
+  std::vector<int> clause;
+  const long most_vars = std::min<long>(
+      max_var, text.size()); // a job cannot name more variables than it has
+                             // bytes, which keeps a short job from taking
+                             // up memory for a huge formula
+  const char *pos = text.data();
+  while (*pos != 0 && *pos != '%') { // some benchmark files end with a % line
+    if (*pos == ' ' || *pos == '\n' || *pos == '\t' || *pos == '\r') {
+      pos++;
+    } else if (*pos == 'c') {
+      pos = strchr(pos, '\n');
+      if (!pos)
+        break;
+    } else if (*pos == 'p') {
+      pos++;
+      while (*pos == ' ' || (*pos >= 'a' && *pos <= 'z')) {
+        pos++; // "cnf", then the number of variables and clauses
+      }
+      char *end;
+      long vars = strtol(pos, &end, 10);
+      if (end == pos || vars < 0) {
+        error = "bad header";
+        return false;
+      }
+      if (vars > most_vars) {
+        error = "more variables than the job has bytes";
+        return false;
+      }
+      solver.num_vars = std::max<int>(solver.num_vars, vars); // variables in
+                                                              // no clause
+                                                              // are still in
+                                                              // the model
+      pos = strchr(pos, '\n');
+      if (!pos)
+        break;
+    } else {
+      char *end;
+      long literal = strtol(pos, &end, 10);
+      if (end == pos) {
+        error = "expected a literal";
+        return false;
+      }
+      if (literal < -most_vars || literal > most_vars) {
+        error = "more variables than the job has bytes";
+        return false;
+      }
+      pos = end;
+      if (literal == 0) {
+        solver.add_clause(clause);
+        solver.num_clauses++;
+        clause.clear();
+      } else {
+        clause.push_back(literal);
+      }
+    }
+  }
+  if (!clause.empty()) { // the last clause was not terminated
+    solver.add_clause(clause);
+    solver.num_clauses++;
+  }
+  return true;
+}
+
+struct Budget { // limits of the job a solver works on
+  const Solver *solver;
+  long long max_conflicts;
+  std::chrono::steady_clock::time_point deadline;
+  bool timed;
+};
+
+int budget_spent(void *data) { // terminate callback of a worker's solver
+  const Budget *budget = static_cast<const Budget *>(data);
+  return (budget->max_conflicts > 0 &&
+          budget->solver->num_conflicts >= budget->max_conflicts) ||
+         (budget->timed && std::chrono::steady_clock::now() >= budget->deadline);
+}
+
+void work_jobs(const Solver &config, JobQueue &queue) { // body of a worker
+  ClauseArena arena;         // kept from one job to the next, so that a
+  std::vector<CRef> clauses; // stream of small formulas reuses the memory
+  Job job;
+  while (queue.pop(job)) {
+    Solver solver;
+    solver.use_restart_policy(config.restart_policy);
+    solver.initial_phase = config.initial_phase;
+    solver.activity_decay = config.activity_decay;
+    solver.walk_enabled = config.walk_enabled;
+    solver.gauss_enabled = config.gauss_enabled;
+    solver.preprocess_enabled = config.preprocess_enabled;
+    solver.arena.memory.swap(arena.memory);
+    solver.clauses.swap(clauses);
+
+    std::string error, output;
+    Result result = RESULT_UNKNOWN;
+    try { // a job too large for the memory left fails alone, rather than
+          // taking the server and the other clients' jobs down with it
+      if (read_formula(solver, job.text, error)) {
+        Budget budget = {
+            &solver, job.max_conflicts,
+            std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(job.max_seconds)),
+            job.max_seconds > 0};
+        solver.terminate = budget_spent;
+        solver.terminate_data = &budget;
+        result = !solver.preprocess<NoTrace>() ? RESULT_UNSAT
+                                               : solver.solve<NoTrace>();
+      } else {
+        output = "c error: " + error + "\n";
+      }
+      output += format_result(result, solver.model, solver.num_vars);
+    } catch (const std::bad_alloc &) {
+      output = "c error: out of memory\n" +
+               format_result(RESULT_UNKNOWN, std::vector<Value>(), 0);
+    }
+    job.client->send(answer(job.id, output));
+
+    if (solver.arena.memory.capacity() <= server_arena_keep) {
+      arena.memory.swap(solver.arena.memory);
+      arena.memory.clear();
+      clauses.swap(solver.clauses);
+      clauses.clear();
+    }
+    job = Job(); // let go of the formula and the client
+  }
+}
+
+void read_jobs(std::shared_ptr<Client> client,
+               std::shared_ptr<JobQueue> queue) { // read jobs until the client
+                                                  // is done. the reader owns
+                                                  // the queue too, since it
+                                                  // may outlive serve()
+  std::string header;
+  while (client->next_line(header)) {
+    Job job;
+    job.client = client;
+    char id[256];
+    unsigned long long size;
+    if (sscanf(header.c_str(), "%255s %lld %lf %llu", id, &job.max_conflicts,
+               &job.max_seconds, &size) != 4 ||
+        size > server_max_job_size) {
+      client->send(answer("?", "c error: bad job header\ns UNKNOWN\n"));
+      return; // the stream cannot be followed any further
+    }
+    job.id = id;
+    if (!client->next_bytes(job.text, size))
+      return;
+    job.text.push_back(0);
+    if (!queue->push(std::move(job)))
+      return; // the server is stopping
+  }
+}
+
+int listen_unix(const char *path) { // returns the listening socket, or -1
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(address.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  strcpy(address.sun_path, path);
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0)
+    return -1;
+  unlink(path); // left behind by an earlier server
+  if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 ||
+      listen(listener, 64) != 0) {
+    close(listener);
+    return -1;
+  }
+  return listener;
+}
+
+bool serve(const Solver &config, const char *socket_path, int num_workers) {
+  int listener = -1;
+  if (socket_path && (listener = listen_unix(socket_path)) < 0) {
+    std::cerr << "error: could not listen on " << socket_path << ": "
+              << strerror(errno) << std::endl;
+    return false;
+  }
+  auto queue = std::make_shared<JobQueue>();
+  queue->limit = server_queue_per_worker * num_workers;
+  std::vector<std::thread> workers;
+  for (int w = 0; w < num_workers; w++) {
+    workers.emplace_back(work_jobs, std::cref(config), std::ref(*queue));
+  }
+
+  if (!socket_path) {
+    auto client = std::make_shared<Client>();
+    client->in_fd = STDIN_FILENO;
+    client->out_fd = STDOUT_FILENO;
+    read_jobs(client, queue);
+  } else {
+    while (true) { // serves until the process is stopped
+      int fd = accept(listener, nullptr, nullptr);
+      if (fd < 0 && (errno == EINTR || errno == ECONNABORTED))
+        continue;
+      if (fd < 0) {
+        std::cerr << "error: could not accept: " << strerror(errno)
+                  << std::endl;
+        break;
+      }
+      auto client = std::make_shared<Client>();
+      client->in_fd = client->out_fd = fd;
+      client->is_socket = true;
+      std::thread(read_jobs, client, queue).detach();
+    }
+    close(listener);
+  }
+  queue->close(); // the jobs already read are still answered
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  return socket_path == nullptr;
+}
@@ -0,0 +1,57 @@
+/* server.h - solving a stream of formulas in one process
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_SERVER_H
+#define FIELDSAT_SERVER_H
+
+#include "solver.h"
+
+#include <string>
+
+// server mode: jobs are read from stdin, or from any number of connections
+// to a unix socket, and solved by a pool of worker threads. each job is a
+// header line followed by the formula in DIMACS, of exactly the given length:
+//
+//   <id> <max conflicts> <max seconds> <length>\n<DIMACS>
+//
+// where a limit of 0 means none. the time limit counts from when a worker
+// takes up the job. the answer is written to the same stream once the job is
+// done, so answers come in the order the jobs finish, not the order they
+// were sent:
+//
+//   <id> <length>\n<output>
+//
+// where the output is what fieldSAT prints for a single formula (an s line,
+// and v lines for a model), with s UNKNOWN if a limit was reached, and a
+// c error line before it if the job could not be read
+
+const size_t server_max_job_size =
+    1ull << 30; // jobs longer than this are refused rather than buffered
+const size_t server_arena_keep =
+    1 << 24; // a worker keeps the clause arena of its last job for the next
+             // unless it grew larger than this many words
+
+bool serve(const Solver &config, const char *socket_path,
+           int num_workers); // serve jobs from stdin if socket_path is null,
+                             // and otherwise from connections to a unix
+                             // socket created there. every job is solved
+                             // with the options of config. returns true once
+                             // stdin ends and every job is answered, and
+                             // false if the socket could not be served
+std::string format_result(Result result, const std::vector<Value> &model,
+                          int num_vars); // see fieldSAT.cpp
+
+#endif
@@ -0,0 +1,871 @@
+/* solver.cpp - input and preprocessing for the fieldSAT solver
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "solver.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+TraceSink trace;
+
+const size_t input_block_size =
+    1 << 20; // number of bytes read at a time when the input is a pipe
+
+struct Input { // the DIMACS input. regular files are mapped into memory in one
+               // go, while pipes (and decompressed input) are read in blocks
+  const char *pos = nullptr; // next byte to be read
+  const char *end = nullptr; // end of the bytes currently available
+  int fd = -1;               // descriptor more blocks are read from, or -1 if
+                             // the whole input is already in memory
+  std::vector<char> block;
+  void *mapping = nullptr;
+  size_t mapping_size = 0;
+  std::vector<pid_t> children; // decompressor processes feeding the input
+
+  bool refill() { // read the next block, returning false at the end of input
+    if (fd < 0)
+      return false;
+    ssize_t n;
+    do {
+      n = read(fd, block.data(), block.size());
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+      return false;
+    pos = block.data();
+    end = pos + n;
+    return true;
+  }
+
+  int peek() { return (pos < end || refill()) ? (unsigned char)*pos : EOF; }
+  void skip() { pos++; }
+};
+
+[[noreturn]] void input_error(const char *message) {
+  std::cerr << "error reading input: " << message << std::endl;
+  exit(1);
+}
+
+const char *decompressor_for(const char *data,
+                             size_t size) { // recognise compressed input by
+                                            // its magic bytes, returning the
+                                            // program that decompresses it
+  const unsigned char *bytes = (const unsigned char *)data;
+  if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b)
+    return "gzip";
+  if (size >= 6 && memcmp(bytes, "\xfd" "7zXZ\0", 6) == 0)
+    return "xz";
+  if (size >= 4 && memcmp(bytes, "\x28\xb5\x2f\xfd", 4) == 0)
+    return "zstd";
+  return nullptr;
+}
+
+int spawn_decompressor(Input &input, const char *program,
+                       int in_fd) { // run "program -dc" reading from in_fd,
+                                    // returning a descriptor for its output
+  int out[2];
+  if (pipe(out) != 0)
+    input_error("could not create pipe");
+  pid_t pid = fork();
+  if (pid < 0)
+    input_error("could not start decompressor");
+  if (pid == 0) {
+    dup2(in_fd, STDIN_FILENO);
+    dup2(out[1], STDOUT_FILENO);
+    close(out[0]);
+    close(out[1]);
+    execlp(program, program, "-dc", (char *)nullptr);
+    std::cerr << "error reading input: could not run " << program << std::endl;
+    _exit(127);
+  }
+  close(out[1]);
+  input.children.push_back(pid);
+  return out[0];
+}
+
+void open_input(Input &input, const char *path) { // open the input file, or
+                                                  // stdin if path is null
+  int fd = path ? open(path, O_RDONLY) : STDIN_FILENO;
+  if (fd < 0)
+    input_error(strerror(errno));
+  input.block.resize(input_block_size);
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+      const char *program = decompressor_for((const char *)mapping, st.st_size);
+      if (program == nullptr) {
+        input.mapping = mapping;
+        input.mapping_size = st.st_size;
+        input.pos = (const char *)mapping;
+        input.end = input.pos + st.st_size;
+        if (fd != STDIN_FILENO)
+          close(fd);
+        return;
+      }
+      munmap(mapping, st.st_size); // compressed, so decompress from the start
+      lseek(fd, 0, SEEK_SET);
+      input.fd = spawn_decompressor(input, program, fd);
+      if (fd != STDIN_FILENO)
+        close(fd);
+      return;
+    }
+  }
+
+  input.fd = fd; // a pipe, so look at the first block to see whether the input
+                 // is compressed
+  if (!input.refill())
+    return;
+  const char *program = decompressor_for(input.pos, input.end - input.pos);
+  if (program == nullptr)
+    return;
+
+  int feed[2]; // the bytes already read are fed to the decompressor, followed
+               // by the rest of the pipe
+  if (pipe(feed) != 0)
+    input_error("could not create pipe");
+  pid_t pid = fork();
+  if (pid < 0)
+    input_error("could not start decompressor");
+  if (pid == 0) {
+    close(feed[0]);
+    do {
+      for (const char *p = input.pos; p < input.end;) {
+        ssize_t n = write(feed[1], p, input.end - p);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          _exit(1);
+        p += n;
+      }
+    } while (input.refill());
+    _exit(0);
+  }
+  input.children.push_back(pid);
+  close(feed[1]);
+  input.fd = spawn_decompressor(input, program, feed[0]);
+  close(feed[0]);
+  if (fd != STDIN_FILENO)
+    close(fd);
+  input.pos = input.end = nullptr;
+}
+
+void close_input(Input &input) {
+  if (input.mapping)
+    munmap(input.mapping, input.mapping_size);
+  if (!input.children.empty())
+    close(input.fd);
+  for (pid_t pid : input.children) {
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0)
+      input_error("decompression failed");
+  }
+}
+
+void skip_whitespace(Input &input) {
+  int c = input.peek();
+  while (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+    input.skip();
+    c = input.peek();
+  }
+}
+
+void skip_line(Input &input) {
+  int c = input.peek();
+  while (c != '\n' && c != EOF) {
+    input.skip();
+    c = input.peek();
+  }
+}
+
+int read_int(Input &input) { // read a (possibly negative) integer directly
+                             // from the input bytes
+  skip_whitespace(input);
+  bool negative = false;
+  if (input.peek() == '-') {
+    negative = true;
+    input.skip();
+  }
+  int c = input.peek();
+  if (c < '0' || c > '9')
+    input_error("expected a number");
+  int64_t value = 0;
+  while (c >= '0' && c <= '9') {
+    value = value * 10 + (c - '0');
+    if (value > INT_MAX)
+      input_error("number out of range");
+    input.skip();
+    c = input.peek();
+  }
+  return negative ? -value : value;
+}
+
+void Solver::parse(const char *path) { // parse the DIMACS CNF input from a
+                                       // file, or from stdin if path is null
+  uint64_t start = cycles();
+  Input input;
+  open_input(input, path);
+
+  std::vector<int> clause;
+  std::vector<int> stamps; // clause number each literal was last seen in,
+                           // indexed by literal, to detect
+                           // duplicate literals without clearing anything
+                           // between clauses
+  int clause_number = 1;
+  bool tautology = false; // whether the current clause contains a literal and
+                          // its negation, in which case it is always
+                          // satisfied and can be dropped
+
+  while (true) {
+    skip_whitespace(input);
+    int c = input.peek();
+    if (c == EOF || c == '%') { // some benchmark files end with a % line
+      break;
+    } else if (c == 'c') {
+      skip_line(input); // lines starting with c are comments, so ignore line
+    } else if (c == 'p') {
+      input.skip();
+      skip_whitespace(input);
+      while (input.peek() >= 'a' && input.peek() <= 'z') {
+        input.skip(); // after the p is "cnf", which can be ignored, then the
+                      // number of variables and clauses
+      }
+      num_vars = read_int(input);
+      num_clauses = read_int(input);
+      if (num_vars < 0 || num_vars > max_var)
+        input_error("number of variables out of range");
+      stamps.resize(2 * (num_vars + 1));
+      clauses.reserve(num_clauses);
+    } else {
+      int literal = read_int(input);
+      if (original_clauses)
+        original_clauses->push_back(literal);
+      if (literal == 0) { // clauses are terminated with 0
+        if (!tautology)
+          hash.add_clause(clause.data(), clause.size());
+        if (clause.empty() && !tautology)
+          empty_clause = true;
+        else if (!tautology)
+          clauses.push_back(arena.alloc(clause, false));
+        clause.clear();
+        tautology = false;
+        clause_number++;
+        continue;
+      }
+      if (std::abs(literal) > max_var)
+        input_error("variable out of range");
+      if (std::abs(literal) > num_vars) { // tolerate headers that undercount
+        num_vars = std::abs(literal);
+        stamps.resize(2 * (num_vars + 1));
+      }
+      literal = from_dimacs(literal);
+      if (stamps[literal] == clause_number)
+        continue; // duplicate literal
+      if (stamps[negate(literal)] == clause_number)
+        tautology = true;
+      stamps[literal] = clause_number;
+      clause.push_back(literal);
+    }
+  }
+  if (!clause.empty() && !tautology) { // last clause was not terminated
+    hash.add_clause(clause.data(), clause.size());
+    clauses.push_back(arena.alloc(clause, false));
+  }
+  if (original_clauses && !original_clauses->empty() &&
+      original_clauses->back() != 0)
+    original_clauses->push_back(0);
+
+  close_input(input);
+  stats.phase_cycles[PHASE_PARSE] += cycles() - start;
+}
+
+bool satisfied(const int *literals, const std::vector<Value> &model) {
+  for (; *literals != 0; literals++) {
+    int var = std::abs(*literals);
+    if (var < model.size() && model[var] == (*literals > 0 ? TRUE : FALSE))
+      return true;
+  }
+  return false;
+}
+
+bool verify_model(const std::vector<int> &clauses,
+                  const std::vector<Value> &model) {
+  size_t num_chunks = std::min<size_t>(
+      std::max(1u, std::thread::hardware_concurrency()),
+      clauses.size() / verify_chunk_size + 1);
+  std::vector<char> chunk_ok(num_chunks, true);
+  auto check = [&](size_t chunk) { // the clauses starting in a range of
+                                   // literals
+    size_t begin = clauses.size() * chunk / num_chunks;
+    size_t end = clauses.size() * (chunk + 1) / num_chunks;
+    while (begin > 0 && begin < end && clauses[begin - 1] != 0)
+      begin++; // skip the clause begun in the previous chunk
+    for (size_t i = begin; i < end && chunk_ok[chunk]; i++) {
+      if (!satisfied(&clauses[i], model))
+        chunk_ok[chunk] = false;
+      while (clauses[i] != 0)
+        i++;
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+    threads.emplace_back(check, chunk);
+  }
+  check(0);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  return std::count(chunk_ok.begin(), chunk_ok.end(), false) == 0;
+}
+
+void Solver::print_progress() {
+  double seconds = stats.seconds();
+  next_progress = seconds + progress_interval;
+  trace.flush(); // keep the lines in order with the verbose trace
+  if (progress_lines++ % 20 == 0)
+    printf("c %9s %11s %12s %10s %8s %7s %9s %6s %5s %9s\n", "seconds",
+           "conflicts", "decisions", "props/s", "restarts", "reduces",
+           "learned", "size", "lbd", "remaining");
+  int root_assigned =
+      trail_decisions.size() > 1 ? trail_decisions[1] : trail.size();
+  int remaining = num_vars - root_assigned -
+                  std::count(eliminated.begin(), eliminated.end(), 1);
+  double learned = std::max(1LL, stats.learned);
+  printf("c %9.2f %11d %12lld %10.0f %8d %7d %9zu %6.1f %5.1f %9d\n", seconds,
+         num_conflicts, stats.decisions, num_propagations / seconds,
+         num_restarts, num_reductions, learned_clauses.size(),
+         stats.learned_literals / learned, stats.learned_lbd / learned,
+         remaining);
+  fflush(stdout);
+}
+
+void Solver::print_stats() const {
+  double seconds = std::max(stats.seconds(), 1e-9);
+  double learned = std::max(1LL, stats.learned);
+  trace.flush();
+  printf("c %-22s %14.3f\n", "seconds", seconds);
+  printf("c %-22s %14d %12.0f per second\n", "conflicts", num_conflicts,
+         num_conflicts / seconds);
+  printf("c %-22s %14lld %12.0f per second\n", "decisions", stats.decisions,
+         stats.decisions / seconds);
+  printf("c %-22s %14lld %12.0f per second\n", "propagations",
+         num_propagations, num_propagations / seconds);
+  printf("c %-22s %14d\n", "restarts", num_restarts);
+  printf("c %-22s %14d\n", "reductions", num_reductions);
+  printf("c %-22s %14d\n", "rephases", num_rephases);
+  printf("c %-22s %14lld\n", "deleted clauses", stats.deleted);
+  printf("c %-22s %14lld\n", "learned clauses", stats.learned);
+  printf("c %-22s %14lld\n", "chronological jumps", stats.chronological);
+  printf("c %-22s %14lld\n", "local search runs", stats.walks);
+  printf("c %-22s %14lld %12.0f per second\n", "local search flips",
+         stats.walk_flips,
+         stats.walk_flips /
+             std::max(stats.seconds(stats.phase_cycles[PHASE_WALK]), 1e-9));
+  printf("c %-22s %14lld\n", "xor constraints", stats.xors);
+  printf("c %-22s %14lld\n", "xor propagations", stats.xor_propagations);
+  printf("c %-22s %14.2f\n", "average learned size",
+         stats.learned_literals / learned);
+  printf("c %-22s %14.2f\n", "average learned LBD",
+         stats.learned_lbd / learned);
+  for (int phase = 0; phase < NUM_PHASES; phase++) {
+    double time = stats.seconds(stats.phase_cycles[phase]);
+    printf("c %-22s %14.3f %11.1f%% of the time\n",
+           (std::string(phase_names[phase]) + " seconds").c_str(), time,
+           100 * time / seconds);
+  }
+  fflush(stdout);
+}
+
+void Solver::print_stats_json() const {
+  double seconds = stats.seconds();
+  double learned = std::max(1LL, stats.learned);
+  trace.flush();
+  printf("{\"variables\": %d, \"clauses\": %d, \"seconds\": %.6f, "
+         "\"conflicts\": %d, \"decisions\": %lld, \"propagations\": %lld, "
+         "\"restarts\": %d, \"reductions\": %d, \"rephases\": %d, "
+         "\"deleted\": %lld, \"learned\": %lld, \"learned_size\": %.3f, "
+         "\"learned_lbd\": %.3f, \"chronological\": %lld, \"walks\": %lld, "
+         "\"walk_flips\": %lld, \"xors\": %lld, \"xor_propagations\": %lld, "
+         "\"phases\": {",
+         num_vars, num_clauses, seconds, num_conflicts, stats.decisions,
+         num_propagations, num_restarts, num_reductions, num_rephases,
+         stats.deleted, stats.learned, stats.learned_literals / learned,
+         stats.learned_lbd / learned, stats.chronological, stats.walks,
+         stats.walk_flips, stats.xors, stats.xor_propagations);
+  for (int phase = 0; phase < NUM_PHASES; phase++) {
+    printf("%s\"%s\": %.6f", phase == 0 ? "" : ", ", phase_names[phase],
+           stats.seconds(stats.phase_cycles[phase]));
+  }
+  printf("}}\n");
+  fflush(stdout);
+}
+
+void Solver::fill_walker(Walker &walker) {
+  std::vector<int> clause;
+  for (CRef ref : clauses) {
+    Clause &c = arena[ref];
+    if (c.learned || c.toRemove)
+      continue; // learned clauses follow from the rest
+    clause.clear();
+    bool satisfied = false;
+    for (int literal : c) {
+      Value value = initialised ? value_of(literal)
+                                : UNASSIGNED; // nothing is assigned yet
+      if (value == UNASSIGNED || var_info[var_of(literal)].level > 0)
+        clause.push_back(literal);
+      else if (value == TRUE)
+        satisfied = true;
+    }
+    if (!satisfied && !clause.empty()) // a clause falsified by root units
+                                       // that are not propagated yet is left
+                                       // to propagate() to find
+      walker.add_clause(clause.data(), clause.size());
+  }
+  walker.build(num_vars);
+}
+
+int Solver::walk(long long effort) {
+  uint64_t start = cycles();
+  Walker walker;
+  fill_walker(walker);
+  std::vector<char> assignment(num_vars + 1);
+  for (int var = 1; var <= num_vars; var++) {
+    assignment[var] = last_assignments[var] == TRUE;
+  }
+  int unsatisfied = walker.walk(
+      assignment,
+      std::max<long long>(effort, walk_literal_effort * walker.num_literals),
+      random(rephase_random_state), portfolio ? &portfolio->stop : nullptr);
+  for (int var = 1; var <= num_vars; var++) {
+    last_assignments[var] = assignment[var] ? TRUE : FALSE;
+  }
+  walk_propagations = num_propagations;
+  stats.walks++;
+  stats.walk_flips += walker.flips;
+  stats.phase_cycles[PHASE_WALK] += cycles() - start;
+  return unsatisfied;
+}
+
+const long long preprocess_budget =
+    200000000; // rough number of literal visits preprocessing may take
+const int subsumption_occurrence_limit =
+    1000; // clauses are only checked against occurrence lists up to this size
+const int elimination_occurrence_limit =
+    200; // variables occurring in more clauses than this are not eliminated
+const int resolvent_size_limit =
+    20; // variables are not eliminated if that would add resolvents longer than
+        // this
+
+const int NOT_SUBSET = -1; // results of Simplifier::subset() other than a
+const int SUBSUMES = -2;   // literal that can be removed
+
+struct Simplifier { // SatELite style preprocessing: backward subsumption,
+                    // self-subsuming strengthening and bounded variable
+                    // elimination, applied to the parsed clauses before the
+                    // solver is initialised
+  ClauseArena &arena; // the parsed clauses, which are simplified in place
+  std::vector<CRef> &clauses;
+  std::vector<char> &eliminated;
+  std::vector<int> &elimination_stack;
+  int num_vars;
+  ProofWriter *proof; // where changes to the clauses are written, if anywhere
+  std::vector<CRef> refs;           // clauses being simplified, by index
+  std::vector<uint64_t> signatures; // one bit per variable (modulo 64) of each
+                                    // clause, to rule out subsets quickly
+  std::vector<char> removed;        // by clause index
+  std::vector<std::vector<int>>
+      occurrences;          // indices of clauses containing each literal,
+                            // indexed by literal. removed clauses are skipped
+                            // rather than deleted
+  std::vector<Value> fixed; // values of literals fixed by unit clauses
+  std::vector<int> units;   // fixed literals still to be simplified away
+  std::vector<int> subsumption_queue; // clauses to check for subsumption
+  std::vector<char> queued;           // by clause index
+  std::vector<int> touched_vars; // variables whose clauses changed, which are
+                                 // candidates for elimination
+  std::vector<char> touched;     // by variable
+  std::vector<int> stamps;       // marks of literals, by literal
+  int stamp = 0;
+  std::vector<int> resolvent;
+  std::vector<int> strengthened; // clause written to the proof by strengthen()
+  long long budget = preprocess_budget;
+  bool unsat = false;
+
+  Simplifier(ClauseArena &arena, std::vector<CRef> &clauses,
+             std::vector<char> &eliminated,
+             std::vector<int> &elimination_stack, int num_vars,
+             ProofWriter *proof)
+      : arena(arena), clauses(clauses), eliminated(eliminated),
+        elimination_stack(elimination_stack), num_vars(num_vars),
+        proof(proof) {}
+
+  uint64_t signature(int index) {
+    uint64_t sig = 0;
+    for (int literal : arena[refs[index]]) {
+      sig |= 1ull << (var_of(literal) & 63);
+    }
+    return sig;
+  }
+
+  void touch(int literal) {
+    if (!touched[var_of(literal)]) {
+      touched[var_of(literal)] = true;
+      touched_vars.push_back(var_of(literal));
+    }
+  }
+
+  void enqueue(int index) {
+    if (!queued[index]) {
+      queued[index] = true;
+      subsumption_queue.push_back(index);
+    }
+  }
+
+  void fix(int literal) { // a unit clause was found
+    if (fixed[literal] == FALSE)
+      unsat = true;
+    if (fixed[literal] != UNASSIGNED)
+      return;
+    fixed[literal] = TRUE;
+    fixed[negate(literal)] = FALSE;
+    units.push_back(literal);
+  }
+
+  void add(CRef ref) {
+    Clause &clause = arena[ref];
+    if (clause.size == 1) { // unit clauses are added back at the end
+      fix(clause[0]);
+      clause.toRemove = true;
+      return;
+    }
+    int index = refs.size();
+    refs.push_back(ref);
+    signatures.push_back(signature(index));
+    removed.push_back(false);
+    queued.push_back(false);
+    for (int literal : clause) {
+      occurrences[literal].push_back(index);
+      touch(literal);
+    }
+    enqueue(index);
+  }
+
+  void remove(int index) {
+    if (proof)
+      proof->remove(arena[refs[index]].begin(), arena[refs[index]].size);
+    discard(index);
+  }
+
+  void discard(int index) { // remove a clause without deleting it from the
+                            // proof
+    removed[index] = true;
+    arena[refs[index]].toRemove = true;
+    for (int literal : arena[refs[index]]) {
+      touch(literal);
+    }
+  }
+
+  void strengthen(int index, int literal) { // remove a literal from a clause
+    Clause &clause = arena[refs[index]];
+    if (proof) { // the shortened clause is added before the original is
+                 // deleted, since it is derived from it
+      strengthened.assign(clause.begin(), clause.end());
+      strengthened.erase(
+          std::find(strengthened.begin(), strengthened.end(), literal));
+      proof->add(strengthened);
+      proof->remove(clause.begin(), clause.size);
+    }
+    int *end = std::remove(clause.begin(), clause.end(), literal);
+    clause.size = end - clause.begin();
+    arena.wasted++;
+    std::vector<int> &list = occurrences[literal];
+    list.erase(std::find(list.begin(), list.end(), index));
+    touch(literal);
+    if (clause.size == 1) {
+      fix(clause[0]);
+      discard(index); // already in the proof as a unit
+      return;
+    }
+    signatures[index] = signature(index);
+    enqueue(index);
+  }
+
+  void propagate_units() { // remove the clauses satisfied by fixed literals,
+                           // and the fixed literals' negations from clauses
+    while (!units.empty() && !unsat) {
+      int literal = units.back();
+      units.pop_back();
+      for (int index : occurrences[literal]) {
+        if (!removed[index])
+          remove(index);
+      }
+      std::vector<int> falsified = occurrences[negate(literal)];
+      for (int index : falsified) {
+        if (!removed[index])
+          strengthen(index, negate(literal));
+      }
+      occurrences[literal].clear();
+      occurrences[negate(literal)].clear();
+    }
+  }
+
+  int subset(int a, int b) { // check whether clause a subsumes clause b. if
+                             // not, but it would after flipping the sign of a
+                             // single literal, then resolving the two clauses
+                             // on it gives b without that literal, which is
+                             // returned
+    Clause &clause_a = arena[refs[a]];
+    Clause &clause_b = arena[refs[b]];
+    if (clause_a.size > clause_b.size ||
+        (signatures[a] & ~signatures[b]) != 0)
+      return NOT_SUBSET;
+    budget -= clause_a.size + clause_b.size;
+    stamp++;
+    for (int literal : clause_b) {
+      stamps[literal] = stamp;
+    }
+    int result = SUBSUMES;
+    for (int literal : clause_a) {
+      if (stamps[literal] == stamp)
+        continue;
+      if (result == SUBSUMES && stamps[negate(literal)] == stamp)
+        result = negate(literal);
+      else
+        return NOT_SUBSET;
+    }
+    return result;
+  }
+
+  void backward_subsume(int index) { // remove or strengthen every clause that
+                                     // this clause subsumes or strengthens
+    int best = -1;
+    size_t best_size = SIZE_MAX;
+    for (int literal : arena[refs[index]]) { // only clauses containing the
+                                             // variable with the fewest
+                                             // occurrences need checking
+      size_t size =
+          occurrences[literal].size() + occurrences[negate(literal)].size();
+      if (size < best_size) {
+        best = literal;
+        best_size = size;
+      }
+    }
+    if (best_size > subsumption_occurrence_limit)
+      return;
+    for (int literal : {best, negate(best)}) {
+      std::vector<int> candidates = occurrences[literal];
+      for (int other : candidates) {
+        if (other == index || removed[other])
+          continue;
+        int result = subset(index, other);
+        if (result == SUBSUMES)
+          remove(other);
+        else if (result != NOT_SUBSET)
+          strengthen(other, result);
+        if (unsat || removed[index])
+          return;
+      }
+    }
+  }
+
+  bool resolve(int a, int b, int var) { // resolve two clauses on a variable
+                                        // into resolvent, returning false if
+                                        // the result is a tautology
+    resolvent.clear();
+    stamp++;
+    for (int literal : arena[refs[a]]) {
+      if (var_of(literal) != var) {
+        stamps[literal] = stamp;
+        resolvent.push_back(literal);
+      }
+    }
+    for (int literal : arena[refs[b]]) {
+      if (var_of(literal) == var || stamps[literal] == stamp)
+        continue;
+      if (stamps[negate(literal)] == stamp)
+        return false;
+      resolvent.push_back(literal);
+    }
+    budget -= resolvent.size();
+    return true;
+  }
+
+  void live_occurrences(int literal, std::vector<int> &list) {
+    list.clear();
+    for (int index : occurrences[literal]) {
+      if (!removed[index])
+        list.push_back(index);
+    }
+  }
+
+  void push_elimination_clause(int index, int pivot) {
+    int size = 1;
+    elimination_stack.push_back(pivot);
+    for (int literal : arena[refs[index]]) {
+      if (literal != pivot) {
+        elimination_stack.push_back(literal);
+        size++;
+      }
+    }
+    elimination_stack.push_back(size);
+  }
+
+  void eliminate(int var) { // replace every clause containing the variable by
+                            // all resolvents on it, as long as that does not
+                            // increase the number of clauses
+    std::vector<int> pos, neg;
+    live_occurrences(make_literal(var, false), pos);
+    live_occurrences(make_literal(var, true), neg);
+    if (pos.size() + neg.size() > elimination_occurrence_limit)
+      return;
+
+    int count = 0;
+    for (int a : pos) {
+      for (int b : neg) {
+        if (resolve(a, b, var)) {
+          count++;
+          if (count > pos.size() + neg.size() ||
+              resolvent.size() > resolvent_size_limit)
+            return;
+        }
+      }
+    }
+
+    // only the clauses of one polarity are needed to reconstruct the
+    // variable's value: it defaults to the other polarity, and it is flipped
+    // if one of the stored clauses is unsatisfied. any resolvent with a
+    // clause of the other polarity is satisfied, so then so is that clause
+    bool positive = pos.size() <= neg.size();
+    for (int index : positive ? pos : neg) {
+      push_elimination_clause(index, make_literal(var, !positive));
+    }
+    elimination_stack.push_back(make_literal(var, positive));
+    elimination_stack.push_back(1);
+
+    for (int a : pos) {
+      for (int b : neg) {
+        if (!resolve(a, b, var))
+          continue;
+        if (resolvent.empty()) {
+          unsat = true;
+          return;
+        }
+        if (proof)
+          proof->add(resolvent);
+        if (resolvent.size() == 1)
+          fix(resolvent[0]);
+        else
+          add(arena.alloc(resolvent, false));
+      }
+    }
+    for (int index : pos) {
+      remove(index);
+    }
+    for (int index : neg) {
+      remove(index);
+    }
+    eliminated[var] = true;
+    occurrences[make_literal(var, false)].clear();
+    occurrences[make_literal(var, true)].clear();
+    propagate_units();
+  }
+
+  bool run() { // returns false if the formula was found to be unsatisfiable
+    occurrences.resize(2 * (num_vars + 1));
+    fixed.resize(2 * (num_vars + 1), UNASSIGNED);
+    stamps.resize(2 * (num_vars + 1));
+    touched.resize(num_vars + 1);
+    for (CRef ref : clauses) {
+      add(ref);
+    }
+    propagate_units();
+
+    while (!unsat && budget > 0) {
+      while (!subsumption_queue.empty() && !unsat && budget > 0) {
+        int index = subsumption_queue.back();
+        subsumption_queue.pop_back();
+        queued[index] = false;
+        if (!removed[index])
+          backward_subsume(index);
+        propagate_units();
+      }
+
+      std::vector<int> candidates;
+      for (int var : touched_vars) {
+        touched[var] = false;
+        if (!eliminated[var] && fixed[make_literal(var, false)] == UNASSIGNED)
+          candidates.push_back(var);
+      }
+      touched_vars.clear();
+      if (candidates.empty())
+        break;
+      std::vector<long long> cost(num_vars + 1);
+      for (int var : candidates) { // try the cheapest variables first
+        cost[var] = (long long)occurrences[make_literal(var, false)].size() *
+                    occurrences[make_literal(var, true)].size();
+      }
+      std::sort(candidates.begin(), candidates.end(),
+                [&cost](int a, int b) { return cost[a] < cost[b]; });
+
+      for (int var : candidates) {
+        if (unsat || budget <= 0)
+          break;
+        if (!eliminated[var] && fixed[make_literal(var, false)] == UNASSIGNED)
+          eliminate(var);
+      }
+    }
+    if (unsat)
+      return false;
+
+    clauses.clear();
+    for (int index = 0; index < refs.size(); index++) {
+      if (removed[index])
+        arena.free(refs[index]);
+      else
+        clauses.push_back(refs[index]);
+    }
+    for (int var = 1; var <= num_vars; var++) {
+      int literal = make_literal(var, false);
+      if (fixed[literal] != UNASSIGNED) {
+        int unit = fixed[literal] == TRUE ? literal : negate(literal);
+        clauses.push_back(arena.alloc(&unit, 1, false));
+      }
+    }
+    return true;
+  }
+};
+
+bool simplify(ClauseArena &arena, std::vector<CRef> &clauses,
+              std::vector<char> &eliminated,
+              std::vector<int> &elimination_stack, int num_vars,
+              ProofWriter *proof) { // returns false if the formula was found
+                                    // to be unsatisfiable
+  Simplifier simplifier(arena, clauses, eliminated, elimination_stack,
+                        num_vars, proof);
+  return simplifier.run();
+}
@@ -0,0 +1,2710 @@
+/* solver.h - the fieldSAT solver
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_SOLVER_H
+#define FIELDSAT_SOLVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "gauss.h"
+#include "proof.h"
+#include "walk.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+typedef uint32_t CRef; // reference to a clause, as its offset into the clause
+                       // arena
+const CRef CREF_UNDEF = UINT32_MAX; // reference to no clause
+const CRef CREF_XOR =
+    1u << 31; // a reason with this bit set stands for the row saved when an
+              // XOR constraint implied the literal, see reason_of(). the
+              // arena never grows this large
+
+enum Tier { // tiers of the learned clause database, see reduce()
+  CORE,     // clauses with a very low LBD, which are never removed
+  TIER2,    // clauses with a low LBD, kept as long as they keep being used
+  LOCAL     // all other learned clauses, which are removed by activity
+};
+
+struct Clause { // header of a clause in the clause arena. the literals of the
+                // clause are stored inline, directly after the header. the
+                // first two literals are the watched literals
+  uint32_t size : 29;
+  uint32_t learned : 1;
+  uint32_t toRemove : 1;  // only relevant for learned clauses
+  uint32_t relocated : 1; // set by the garbage collector once the clause has
+                          // been moved, in which case its new reference is
+                          // stored in place of its first literal
+  float activity;         // only relevant for learned clauses
+  uint32_t lbd : 14; // literal block distance, i.e. number of distinct decision
+                     // levels among the literals, when last computed, up to
+                     // max_lbd. only relevant for learned clauses
+  uint32_t search : 14; // where propagate() last found a replacement watch,
+                        // so the next search in a long clause carries on
+                        // from there. at least 2, and at most max_search
+  uint32_t tier : 2; // only relevant for learned clauses
+  uint32_t used : 1; // whether the clause took part in conflict analysis since
+                     // the last reduction. only relevant for learned clauses
+  uint32_t vivified : 1; // whether inprocessing already tried to shorten the
+                         // clause. only relevant for learned clauses
+
+  int *literals() { return reinterpret_cast<int *>(this + 1); }
+  int &operator[](int i) { return literals()[i]; }
+  int *begin() { return literals(); }
+  int *end() { return literals() + size; }
+};
+
+const uint32_t max_lbd = (1 << 14) - 1; // larger LBDs are stored as this
+const uint32_t max_search = (1 << 14) - 1; // searches in longer clauses
+                                           // carry on from here at most
+
+struct ClauseArena { // one contiguous buffer holding every clause, so clauses
+                     // are close together in memory and can be referred to by
+                     // 32-bit offsets rather than pointers
+  std::vector<uint32_t> memory;
+  uint32_t wasted = 0; // number of words used by clauses that have been freed
+
+  static const uint32_t header_words = sizeof(Clause) / sizeof(uint32_t);
+
+  Clause &operator[](CRef ref) {
+    return *reinterpret_cast<Clause *>(&memory[ref]);
+  }
+
+  CRef alloc(const int *literals, uint32_t size,
+             bool learned) { // note: this may move the buffer, invalidating
+                             // any Clause references held by the caller
+    CRef ref = memory.size();
+    memory.resize(memory.size() + header_words + size);
+    Clause &clause = (*this)[ref];
+    clause.size = size;
+    clause.learned = learned;
+    clause.toRemove = false;
+    clause.relocated = false;
+    clause.activity = 0;
+    clause.lbd = std::min(size, max_lbd);
+    clause.search = 2;
+    clause.tier = LOCAL;
+    clause.used = learned; // a new learned clause has had no chance to be
+                           // used yet, so it is kept by the next reduction
+    clause.vivified = false;
+    std::copy(literals, literals + size, clause.literals());
+    return ref;
+  }
+
+  CRef alloc(const std::vector<int> &literals, bool learned) {
+    return alloc(literals.data(), literals.size(), learned);
+  }
+
+  void free(CRef ref) { wasted += header_words + (*this)[ref].size; }
+
+  CRef relocate(CRef ref, ClauseArena &to) { // move a clause into another
+                                             // arena, returning its new
+                                             // reference. clauses that have
+                                             // already been moved are only
+                                             // looked up
+    Clause &clause = (*this)[ref];
+    if (clause.relocated)
+      return clause[0];
+    CRef new_ref = to.memory.size();
+    to.memory.insert(to.memory.end(), memory.begin() + ref,
+                     memory.begin() + ref + header_words +
+                         clause.size); // copy the header and literals as is
+    clause.relocated = true;
+    clause[0] = new_ref;
+    return new_ref;
+  }
+};
+
+struct Watcher { // entry in a watch list
+  CRef clause;
+  int blocker; // some other literal of the clause. if it is true, the clause is
+               // satisfied and can be skipped without reading it. for binary
+               // clauses, this is the other literal of the clause
+};
+
+enum Value : int8_t { TRUE, FALSE, UNASSIGNED };
+
+struct VarInfo { // search state of a variable that is only meaningful while
+                 // it is assigned. the two are read together for every
+                 // literal visited by conflict analysis, so they share a
+                 // cache line
+  int level = -1;           // decision level it was assigned at, or -1
+  CRef reason = CREF_UNDEF; // clause that implied its value, if any
+};
+static_assert(sizeof(VarInfo) == 8, "VarInfo should pack into 8 bytes");
+
+enum TraceEvent { // kinds of event written to the verbose trace
+  TRACE_DECIDE,
+  TRACE_CONFLICT,
+  TRACE_BACKJUMP,
+  TRACE_RESTART,
+  TRACE_REDUCE,
+  TRACE_PREPROCESS,
+  TRACE_INPROCESS,
+  TRACE_PROPAGATE,
+  TRACE_ASSIGN,
+  NUM_TRACE_EVENTS
+};
+
+const char *const trace_event_names[NUM_TRACE_EVENTS] = {
+    "decide",     "conflict",  "backjump",  "restart", "reduce",
+    "preprocess", "inprocess", "propagate", "assign"};
+const int trace_event_levels[NUM_TRACE_EVENTS] = {
+    1, 1, 1, 1, 1, 1, 1, 2, 2}; // minimum trace level at which each event is
+                             // written. level 1 events happen at most once
+                             // per conflict or decision, level 2 events once
+                             // per assignment
+
+struct TraceSink { // buffered output for the verbose trace. lines are
+                   // collected in a large buffer which is only written out
+                   // when full, rather than flushing stdout on every line
+  static const size_t capacity = 1 << 16;
+  char buffer[capacity];
+  size_t used = 0;
+  int level = 2; // events above this level are not written
+  bool events[NUM_TRACE_EVENTS] = {true, true, true, true, true,
+                                   true, true, true, true};
+
+  bool wants(TraceEvent event) const {
+    return events[event] && trace_event_levels[event] <= level;
+  }
+
+  void flush() {
+    fwrite(buffer, 1, used, stdout);
+    fflush(stdout);
+    used = 0;
+  }
+
+  void write(const char *data, size_t size) {
+    if (used + size > capacity) {
+      flush();
+      if (size > capacity) {
+        fwrite(data, 1, size, stdout);
+        return;
+      }
+    }
+    memcpy(buffer + used, data, size);
+    used += size;
+  }
+
+  TraceSink &operator<<(const char *string) {
+    write(string, strlen(string));
+    return *this;
+  }
+
+  TraceSink &operator<<(long long value) {
+    char digits[24];
+    write(digits, snprintf(digits, sizeof(digits), "%lld", value));
+    return *this;
+  }
+
+  TraceSink &operator<<(int value) { return *this << (long long)value; }
+  TraceSink &operator<<(size_t value) { return *this << (long long)value; }
+};
+
+
+extern TraceSink trace; // shared by every solver, see sat_loop()
+
+// the search functions are templated on a trace policy, so the verbose trace
+// is compiled out of the normal build entirely: every trace statement is
+// guarded by Trace::enabled, which is a compile time constant
+
+struct NoTrace {
+  static const bool enabled = false;
+};
+
+struct VerboseTrace {
+  static const bool enabled = true;
+};
+
+enum Phase { // parts of the run timed for the statistics summary
+  PHASE_PARSE,
+  PHASE_PREPROCESS,
+  PHASE_INITIALISE,
+  PHASE_PROPAGATE,
+  PHASE_ANALYSE,
+  PHASE_REDUCE,
+  PHASE_INPROCESS,
+  PHASE_WALK,
+  NUM_PHASES
+};
+
+const char *const phase_names[NUM_PHASES] = {
+    "parse",   "preprocess", "initialise", "propagate",
+    "analyse", "reduce",     "inprocess",  "walk"};
+
+inline uint64_t cycles() { // cheap timestamp for the phase timers: the time
+                           // stamp counter where there is one, otherwise
+                           // nanoseconds. only differences are meaningful
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+inline void prefetch(const void *address) { // start loading the cache line
+                                            // holding address, without
+                                            // waiting for it
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#endif
+}
+
+const int watch_prefetch_distance =
+    4; // propagate() prefetches the clause of the watcher this many entries
+       // ahead of the one it is visiting
+const int trail_prefetch_distance =
+    2; // and the watchers of the trail literal this many entries ahead, with
+       // the vectors of the watch lists one literal further
+
+const int long_clause_size =
+    16; // clauses of at least this size search for a replacement watch from
+        // where the last search stopped, with the vector kernels
+const int simd_min_literals =
+    16; // searches over fewer literals than this are left to the scalar loop,
+        // since the vector ones would spend most of their time on the tail
+const int value_padding =
+    3; // bytes after the last literal's value, so that a 32-bit gather of
+       // any literal's value stays inside the array
+
+inline int find_non_false_scalar(const int *literals, int from, int to,
+                                 const Value *values) {
+  for (int k = from; k < to; k++) {
+    if (values[literals[k]] != FALSE)
+      return k;
+  }
+  return to;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FIELDSAT_SIMD 1 // the vector kernels are compiled for their own
+                        // targets, and only run if the CPU has them
+
+__attribute__((target("avx2"))) inline int
+find_non_false_avx2(const int *literals, int from, int to,
+                    const Value *values) { // 8 literals at a time, gathering
+                                           // 32 bits at each value and
+                                           // keeping the low byte
+  const __m256i low_byte = _mm256_set1_epi32(0xff);
+  const __m256i false_value = _mm256_set1_epi32(FALSE);
+  int k = from;
+  for (; k + 8 <= to; k += 8) {
+    __m256i indices =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(literals + k));
+    __m256i gathered = _mm256_i32gather_epi32(
+        reinterpret_cast<const int *>(values), indices, 1);
+    __m256i is_false = _mm256_cmpeq_epi32(
+        _mm256_and_si256(gathered, low_byte), false_value);
+    unsigned found = ~_mm256_movemask_ps(_mm256_castsi256_ps(is_false)) & 0xff;
+    if (found != 0)
+      return k + __builtin_ctz(found);
+  }
+  return find_non_false_scalar(literals, k, to, values);
+}
+
+__attribute__((target("avx512f"))) inline int
+find_non_false_avx512(const int *literals, int from, int to,
+                      const Value *values) { // the same, 16 at a time
+  const __m512i low_byte = _mm512_set1_epi32(0xff);
+  const __m512i false_value = _mm512_set1_epi32(FALSE);
+  int k = from;
+  for (; k + 16 <= to; k += 16) {
+    __m512i indices = _mm512_loadu_si512(literals + k);
+    __m512i gathered = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), 0xffff, indices, values,
+        1); // the unmasked gather starts from an undefined vector, which
+            // GCC takes for an uninitialised read
+    __mmask16 found = _mm512_cmpneq_epi32_mask(
+        _mm512_and_si512(gathered, low_byte), false_value);
+    if (found != 0)
+      return k + __builtin_ctz(found);
+  }
+  return find_non_false_scalar(literals, k, to, values);
+}
+#endif
+
+enum SimdLevel { SIMD_NONE, SIMD_AVX2, SIMD_AVX512 };
+
+inline SimdLevel detect_simd() {
+#ifdef FIELDSAT_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return SIMD_AVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return SIMD_AVX2;
+#endif
+  return SIMD_NONE;
+}
+
+inline const SimdLevel simd_level = detect_simd(); // checked once, at start up
+
+inline int find_non_false(const int *literals, int from, int to,
+                          const Value *values) { // index of the first literal
+                                                 // in [from, to) that is not
+                                                 // false, or to if there is
+                                                 // none
+#ifdef FIELDSAT_SIMD
+  if (to - from >= simd_min_literals) {
+    if (simd_level == SIMD_AVX512)
+      return find_non_false_avx512(literals, from, to, values);
+    if (simd_level == SIMD_AVX2)
+      return find_non_false_avx2(literals, from, to, values);
+  }
+#endif
+  return find_non_false_scalar(literals, from, to, values);
+}
+
+inline uint64_t mix64(uint64_t x) { // splitmix64 finaliser, for hashing
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+struct FormulaHash { // 128-bit hash of a formula's clauses, built by parse()
+                     // one clause at a time. it does not depend on the order
+                     // of the clauses, nor on the order of the literals in
+                     // them, so reordered copies of a formula share it
+  uint64_t words[2] = {0, 0};
+
+  void add_clause(const int *literals, int size) {
+    uint64_t low = size, high = size;
+    for (int i = 0; i < size; i++) {
+      low += mix64(literals[i]);
+      high += mix64(literals[i] ^ 0x5851f42d4c957f2dull);
+    }
+    words[0] += mix64(low);
+    words[1] += mix64(high ^ 0x2545f4914f6cdd1dull);
+  }
+
+  bool operator==(const FormulaHash &other) const {
+    return words[0] == other.words[0] && words[1] == other.words[1];
+  }
+};
+
+struct Stats { // counters and timers kept alongside the search state, for
+               // the progress lines and the final summary
+  long long decisions = 0;
+  long long deleted = 0;          // learned clauses removed by reduce()
+  long long learned = 0;          // learned clauses, including units
+  long long learned_literals = 0; // total size of the learned clauses
+  long long learned_lbd = 0;      // total LBD of the learned clauses
+  long long chronological = 0;    // backjumps that only went back one level
+  long long walks = 0;            // local search runs
+  long long walk_flips = 0;       // variables flipped by local search
+  long long xors = 0;             // XOR constraints found by initialise()
+  long long xor_propagations = 0; // literals implied by XOR constraints
+  uint64_t phase_cycles[NUM_PHASES] = {};
+
+  uint64_t start_cycles = cycles(); // when the solver was created, so cycles
+                                    // can be converted to seconds
+  std::chrono::steady_clock::time_point start_time =
+      std::chrono::steady_clock::now();
+
+  void add(const Stats &other) { // count another solver's search in these
+                                 // counters too
+    decisions += other.decisions;
+    deleted += other.deleted;
+    learned += other.learned;
+    learned_literals += other.learned_literals;
+    learned_lbd += other.learned_lbd;
+    chronological += other.chronological;
+    walks += other.walks;
+    walk_flips += other.walk_flips;
+    xors += other.xors;
+    xor_propagations += other.xor_propagations;
+    for (int phase = 0; phase < NUM_PHASES; phase++) {
+      phase_cycles[phase] += other.phase_cycles[phase];
+    }
+  }
+
+  double seconds() const { // wall clock time since the solver was created
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_time)
+        .count();
+  }
+
+  double seconds(uint64_t cycles_taken) const { // convert a number of cycles,
+                                                // using the rate measured
+                                                // since the solver was created
+    uint64_t elapsed = cycles() - start_cycles;
+    return elapsed == 0 ? 0 : seconds() * cycles_taken / elapsed;
+  }
+};
+
+
+
+const int max_var =
+    (1 << 30) - 2; // largest variable number, so that both of its literals
+                   // and the size 2 * (num_vars + 1) of the arrays indexed by
+                   // literal fit in an int
+
+inline int make_literal(int var, bool negative) { return 2 * var + negative; }
+inline int var_of(int literal) { return literal >> 1; }
+inline int negate(int literal) { return literal ^ 1; }
+inline bool is_negative(int literal) { return literal & 1; }
+
+inline int from_dimacs(int literal) { // convert a (nonzero) DIMACS literal
+  return literal > 0 ? make_literal(literal, false)
+                     : make_literal(-literal, true);
+}
+
+inline int to_dimacs(int literal) {
+  return is_negative(literal) ? -var_of(literal) : var_of(literal);
+}
+
+const double activity_rescale_limit =
+    1e100; // once an activity exceeds this, all activities (and the
+           // increment) are scaled down to avoid overflow
+
+const int reduction_threshold =
+    2000; // threshold of number of conflicts before the clause list is first
+          // reduced
+const int reduction_increment =
+    300; // the number of conflicts between reductions grows by this much after
+         // every reduction
+const int core_lbd_limit = 2;  // learned clauses with an LBD up to this are
+                               // kept forever
+const int tier2_lbd_limit = 6; // learned clauses with an LBD up to this are
+                               // kept while they are being used
+const double clause_activity_decay =
+    0.95; // amount to decay clause activity by when a conflict is found
+const double clause_activity_rescale_limit =
+    1e20; // once a clause activity exceeds this, all clause activities (and
+          // the increment) are scaled down to avoid overflow
+
+enum RestartPolicy { // schedules deciding when the solver restarts
+  RESTART_GEOMETRIC,   // number of conflicts between restarts grows by 1.5x
+  RESTART_LUBY,        // number of conflicts between restarts follows the
+                       // luby sequence (1, 1, 2, 1, 1, 2, 4, ...)
+  RESTART_GLUCOSE      // restart when the LBD of recently learned clauses is
+                       // high compared to the long term average, or when a
+                       // luby schedule runs out without that happening
+};
+
+struct EMA { // exponential moving average, corrected for its zero
+             // initialisation so it is meaningful from the first update
+  double alpha;     // weight of each new value
+  double biased = 0;
+  double beta = 1;  // weight still held by the initial zero
+  double value = 0;
+
+  EMA(double alpha) : alpha(alpha) {}
+
+  void update(double x) {
+    biased += alpha * (x - biased);
+    beta *= 1 - alpha;
+    value = biased / (1 - beta);
+  }
+};
+
+const int luby_unit = 100; // conflicts per unit of the luby sequence
+const int backstop_luby_unit =
+    1000; // conflicts per unit of the luby sequence the glucose policy
+          // restarts by when its LBD test does not fire
+const double restart_margin =
+    1.25; // with the glucose policy, restart once lbd_fast is this much over
+          // lbd_slow
+const int restart_min_conflicts =
+    50; // with the glucose policy, minimum number of conflicts between
+        // restarts
+
+const int chrono_threshold =
+    100; // backjumps over more decision levels than this only go back one
+         // level, keeping the rest of the trail (chronological backtracking)
+
+enum Rephase { // ways of resetting the saved phases, see rephase()
+  REPHASE_ORIGINAL, // back to the initial phase
+  REPHASE_INVERTED, // the opposite of the initial phase
+  REPHASE_BEST,     // the assignment of the largest conflict-free trail
+  REPHASE_RANDOM,   // a random phase for every variable
+  REPHASE_WALK      // the best assignment found by local search, see walk()
+};
+
+const Rephase rephase_schedule[] = {
+    REPHASE_BEST, REPHASE_WALK, REPHASE_INVERTED,
+    REPHASE_BEST, REPHASE_WALK, REPHASE_RANDOM,
+    REPHASE_BEST, REPHASE_WALK, REPHASE_ORIGINAL}; // repeated in order
+const int rephase_interval =
+    1000; // conflicts before the first rephasing. the gap grows by this much
+          // after each one
+
+const double walk_effort =
+    0.2; // ticks a local search run may spend, as a fraction of the
+          // propagations made since the previous run
+const int walk_literal_effort =
+    50; // ticks a local search run may always spend for each literal of
+        // the clauses it searches, which costs about as much to set up
+
+const int inprocess_interval =
+    5000; // number of conflicts between inprocessing runs. a run starts at
+          // the first restart once the interval has passed
+const double inprocess_effort =
+    0.1; // fraction of the propagations made since the last inprocessing run
+         // that the next run may spend
+const long long inprocess_min_effort =
+    20000; // number of propagations an inprocessing run may always spend
+
+const int lookahead_candidates =
+    64; // number of variables make_cubes() looks ahead on for each split,
+        // chosen by number of occurrences
+
+typedef std::vector<int> Cube; // DIMACS literals assumed together, which
+                               // describe one part of the search space
+
+struct Heap { // binary max-heap of variables ordered by activity, used by
+              // decide() to find the most active unassigned variable without
+              // scanning every variable. assigned variables are removed lazily
+              // when they reach the top, and reinserted when unassigned
+  std::vector<int> heap;    // variables in heap order
+  std::vector<int> indices; // position of each variable in the heap, or -1 if
+                            // it is not in the heap
+  const std::vector<double> *activity = nullptr; // activities of the solver
+                                                 // owning the heap
+
+  static int parent(int i) { return (i - 1) / 2; }
+  static int left(int i) { return 2 * i + 1; }
+  static int right(int i) { return 2 * i + 2; }
+
+  double score(int var) const { return (*activity)[var]; }
+  bool empty() const { return heap.empty(); }
+  int top() const { return heap[0]; }
+  bool contains(int var) const {
+    return var < indices.size() && indices[var] >= 0;
+  }
+
+  void percolate_up(int i) {
+    int var = heap[i];
+    while (i > 0 && score(heap[parent(i)]) < score(var)) {
+      heap[i] = heap[parent(i)];
+      indices[heap[i]] = i;
+      i = parent(i);
+    }
+    heap[i] = var;
+    indices[var] = i;
+  }
+
+  void percolate_down(int i) {
+    int var = heap[i];
+    while (left(i) < heap.size()) {
+      int child = (right(i) < heap.size() &&
+                   score(heap[right(i)]) > score(heap[left(i)]))
+                      ? right(i)
+                      : left(i);
+      if (!(score(heap[child]) > score(var)))
+        break;
+      heap[i] = heap[child];
+      indices[heap[i]] = i;
+      i = child;
+    }
+    heap[i] = var;
+    indices[var] = i;
+  }
+
+  void insert(int var) {
+    if (var >= indices.size())
+      indices.resize(var + 1, -1);
+    if (contains(var))
+      return;
+    indices[var] = heap.size();
+    heap.push_back(var);
+    percolate_up(indices[var]);
+  }
+
+  void increase(int var) { // restore heap order after var's activity grew
+    if (contains(var))
+      percolate_up(indices[var]);
+  }
+
+  int pop() { // remove and return the variable with the highest activity
+    int var = heap[0];
+    heap[0] = heap.back();
+    indices[heap[0]] = 0;
+    indices[var] = -1;
+    heap.pop_back();
+    if (heap.size() > 1)
+      percolate_down(0);
+    return var;
+  }
+};
+
+const int preprocess_clause_limit =
+    10000000; // formulas with more clauses than this are not preprocessed, to
+              // bound the memory used by occurrence lists
+
+bool simplify(ClauseArena &arena, std::vector<CRef> &clauses,
+              std::vector<char> &eliminated,
+              std::vector<int> &elimination_stack, int num_vars,
+              ProofWriter *proof); // see Simplifier in solver.cpp. changes to
+                                   // the clauses are written to the proof,
+                                   // if there is one
+
+bool find_xors(ClauseArena &arena, const std::vector<CRef> &clauses,
+               int num_vars,
+               XorMatrix &matrix); // see gauss.cpp. recover the XOR
+                                   // constraints encoded by the irredundant
+                                   // clauses. returns false if they have no
+                                   // solution
+
+enum Result { // outcome of a search, numbered as in the IPASIR interface
+  RESULT_UNKNOWN = 0, // the search was stopped before it finished
+  RESULT_SAT = 10,
+  RESULT_UNSAT = 20
+};
+
+const int share_lbd_limit = 2; // learned clauses with an LBD up to this are
+                               // shared with the rest of a portfolio, as are
+                               // all learned units
+const int share_size_limit =
+    8; // learned clauses longer than this are never shared
+
+struct ExportRing { // clauses exported by one solver of a portfolio. only the
+                    // owner writes to the ring, and the other solvers read it
+                    // without locking: each slot has a sequence number that is
+                    // odd while the slot is being written, so a reader can
+                    // tell if a clause was overwritten while it was copied
+  static const uint64_t capacity = 1 << 12; // once the ring is full, the
+                                            // oldest clauses are overwritten
+  struct Slot {
+    std::atomic<uint64_t> sequence{0}; // 2n + 1 while the nth clause is
+                                       // written, 2n + 2 once it is complete
+    std::atomic<int> size{0};
+    std::atomic<int> literals[share_size_limit];
+  };
+  Slot slots[capacity];
+  alignas(64) std::atomic<uint64_t> head{0}; // number of clauses exported
+
+  void push(const int *literals, int size) { // only called by the owner
+    uint64_t n = head.load(std::memory_order_relaxed);
+    Slot &slot = slots[n % capacity];
+    slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.size.store(size, std::memory_order_relaxed);
+    for (int i = 0; i < size; i++) {
+      slot.literals[i].store(literals[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * n + 2, std::memory_order_release);
+    head.store(n + 1, std::memory_order_release);
+  }
+
+  bool read(uint64_t n, std::vector<int> &clause) { // copy the nth clause,
+                                                    // returning false if it
+                                                    // was overwritten
+    Slot &slot = slots[n % capacity];
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * n + 2)
+      return false;
+    clause.resize(slot.size.load(std::memory_order_relaxed));
+    for (int i = 0; i < clause.size(); i++) {
+      clause[i] = slot.literals[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;
+  }
+};
+
+struct Portfolio { // state shared by the solvers of a portfolio, which run
+                   // diversified copies of the same formula in parallel
+  std::vector<ExportRing> rings; // one for each solver
+  std::atomic<bool> stop{false}; // set once some solver has finished
+  std::atomic<int> winner{-1};   // index of the first solver to finish
+
+  Portfolio(int size) : rings(size) {}
+};
+
+const size_t verify_chunk_size =
+    1 << 20; // literals of the input checked by each thread of verify_model()
+
+bool verify_model(const std::vector<int> &clauses,
+                  const std::vector<Value> &model); // see solver.cpp. checks
+                                                    // every zero terminated
+                                                    // clause in parallel
+                                                    // chunks
+
+struct Solver { // one instance of the CDCL solver, holding all of its
+                // search state, so several can run side by side
+  int num_vars = 0, num_clauses = 0;
+  FormulaHash hash; // of the clauses read by parse()
+  bool empty_clause = false; // whether the input contains an empty clause,
+                             // which makes it trivially unsatisfiable
+
+  std::vector<char> eliminated; // whether each variable was eliminated by
+                                // preprocess(), indexed by variable
+  std::vector<int>
+      elimination_stack; // clauses removed by variable elimination, which are
+                         // needed to extend a model of the remaining clauses to
+                         // the eliminated variables. each clause is stored as
+                         // its literals, starting with the literal of the
+                         // eliminated variable, followed by its size
+  std::vector<Value> model; // satisfying assignment found by the solver,
+                            // indexed by variable
+  ClauseArena arena;        // storage for every clause
+  std::vector<CRef> clauses; // all clauses, including learned clauses
+
+  // internally, the literals of variable v are encoded as 2v (v) and 2v + 1
+  // (-v), so a literal can index lists directly and its negation is found by
+  // flipping the lowest bit. DIMACS literals are only converted at the input
+  // and output boundaries
+
+  std::vector<int> trail; // all assignments in chronological order
+  int trail_head = 0;     // index of the most recently propagated assignment
+  bool trail_out_of_order =
+      false; // set by a chronological backjump until the next backtrack to
+             // the root. literals can then be implied below the current level
+
+  std::vector<Value> values; // value of every literal, indexed by literal. a
+                             // literal and its negation are always assigned
+                             // together, so a literal's value is a single load
+  int assigned_vars = 0;     // number of variables that are assigned
+
+  std::vector<Value> last_assignments; // last assignment to each variable,
+                                       // ignoring backtracking. used when
+                                       // deciding a variable's value, and
+                                       // defaults to false
+  std::vector<Value> target_phases; // assignment of the largest conflict-free
+                                    // trail since the last rephasing, or
+                                    // UNASSIGNED. preferred by decide()
+  std::vector<Value> best_phases;   // the same since the last best rephasing
+  int target_assigned = 0;          // size of the trail in target_phases
+  int best_assigned = 0;            // size of the trail in best_phases
+  int num_rephases = 0;
+  int next_rephase = rephase_interval; // number of conflicts at which the
+                                       // phases are next reset
+
+  std::vector<std::vector<Watcher>>
+      watchers; // contains lists of all clauses with more than two literals
+                // watching a literal, indexed by literal
+  std::vector<std::vector<Watcher>>
+      binary_watchers; // contains lists of all binary clauses containing a
+                       // literal, indexed by literal.
+                       // binary clauses are propagated using the blocker alone
+  std::vector<char> dirty; // whether the watch lists of a literal contain
+                           // removed clauses, indexed by literal
+  std::vector<int> dirty_literals; // literals marked in dirty
+
+  std::vector<int> trail_decisions; // index of the beginning of each decision
+                                    // level in the trail
+  std::vector<VarInfo> var_info; // level and reason of each variable
+
+  CRef conflict_clause = CREF_UNDEF; // most recent conflict clause
+
+  std::vector<double> activity; // activity of a variable, indexed by variable
+  double activity_inc =
+      1; // amount to increment activity by when a conflict is found. this
+         // grows by 1 / activity_decay after every conflict, which has the
+         // same effect on the order of activities as decaying every activity
+  double activity_decay =
+      0.95; // amount to decay activity by when a conflict is found
+
+  Heap order_heap; // unassigned (and possibly some assigned) variables, ordered
+                   // by activity
+
+  std::vector<CRef> learned_clauses; // references to all learned clauses
+  std::vector<int> learned_clause;   // clause built by analyse(), reused
+                                     // between conflicts to avoid allocating
+  int learned_lbd = 0;               // LBD of learned_clause
+  std::vector<int> level_stamps; // used by compute_lbd() to count levels.
+                                 // stamps are never cleared; each call uses a
+                                 // new stamp
+  int lbd_stamp = 0;
+  std::vector<char> seen; // variables in (or resolved out of) the clause being
+                          // learned. cleared again by analyse() once it is done
+  std::vector<int> analyse_stack;   // literals left to check by redundant()
+  std::vector<int> analyse_toclear; // literals whose variables are marked in
+                                    // seen, so they can be cleared afterwards
+  int num_conflicts = 0; // number of conflicts that have occurred
+  int next_reduction = reduction_threshold; // number of conflicts at which the
+                                            // clause list is next reduced
+  int num_reductions = 0;
+  double clause_activity_inc =
+      1; // amount to increase clause activity by when a conflict is found.
+         // grows by 1 / clause_activity_decay after every conflict
+
+  RestartPolicy restart_policy = RESTART_GLUCOSE;
+  int num_restarts = 0;
+  int conflicts_since_restart = 0;
+  int max_conflicts =
+      backstop_luby_unit; // threshold of number of conflicts before solver is
+                          // restarted (geometric and luby policies, and the
+                          // glucose policy's backstop)
+  int num_forced_restarts = 0; // restarts made by the glucose policy's
+                               // backstop
+  EMA lbd_fast{1.0 / 32}; // average LBD of the most recently learned clauses
+  EMA lbd_slow{1.0 / 16384}; // average LBD of learned clauses in the long term
+
+  long long num_propagations = 0; // number of literals propagated so far
+  int next_inprocess = inprocess_interval;
+  bool inprocess_pending = false; // set by backjump() when a restart finds
+                                  // inprocessing due, so sat_loop() runs it
+  long long inprocess_propagations =
+      0; // num_propagations when the last inprocessing run finished
+  int probe_cursor = 1; // next variable to probe. each run carries on from
+                        // where the previous one ran out of effort
+  std::vector<int> probe_stamps; // literals implied by the last probe are
+                                 // stamped with probe_stamp
+  int probe_stamp = 0;
+
+  bool gauss_enabled = true; // whether initialise() looks for XOR
+                             // constraints to propagate by Gauss-Jordan
+                             // elimination. never used with a proof
+  XorMatrix xors;
+  int xor_head = 0; // index of the next trail literal to tell xors about
+  std::vector<uint64_t>
+      xor_reasons; // for each literal implied by xors, in trail order, a copy
+                   // of the row that implied it, from which reason_of()
+                   // builds its reason clause if analysis needs it
+  std::vector<int> xor_implied; // the literal of each row in xor_reasons
+  CRef xor_conflict = CREF_UNDEF; // clause built for the last conflict found
+                                  // by xors, freed once it has been analysed
+
+  bool walk_enabled = true;       // whether local search runs before the
+                                 // search and at rephasings
+  long long walk_propagations = 0; // num_propagations at the last walk()
+
+  Value initial_phase = FALSE; // value each variable is first decided to, or
+                               // UNASSIGNED for a random one
+  uint64_t random_state = 0;   // state of the random number generator. if
+                               // nonzero, initial activities are perturbed by
+                               // small random amounts to break ties
+
+  Portfolio *portfolio = nullptr; // the portfolio the solver is part of, if
+                                  // any
+  int portfolio_index = 0;
+  std::vector<uint64_t> import_cursors; // number of clauses imported from
+                                        // each ring of the portfolio
+  bool import_pending = false; // set by restart(), so sat_loop() imports the
+                               // clauses shared by the other solvers
+  std::vector<int> shared_clause; // clause being imported, reused between
+                                  // clauses to avoid allocating
+
+  bool preprocess_enabled = true; // must be turned off if clauses are added
+                                  // after solving, since they could contain
+                                  // eliminated variables
+  bool initialised = false;  // once set, add_clause() attaches clauses
+                             // directly rather than storing them for
+                             // initialise()
+  int allocated_vars = 0;    // number of variables grow() has made room for
+  std::vector<int> added_clause; // clause being added, reused between clauses
+  std::vector<int> assumptions;  // literals assumed by the current solve()
+                                 // call. assumption i is decided at level
+                                 // i + 1, before any other variable
+  std::vector<char> assumption_failed; // by literal, see failed()
+  std::vector<int> failed_assumptions; // literals marked in assumption_failed
+
+  int (*terminate)(void *) = nullptr; // polled after every conflict; the
+                                      // search stops once it returns nonzero
+  void *terminate_data = nullptr;
+  void (*learn)(void *, int *) = nullptr; // given every learned clause of up
+                                          // to learn_max_size literals, in
+                                          // DIMACS form and zero terminated
+  void *learn_data = nullptr;
+  int learn_max_size = 0;
+  std::vector<int> learn_buffer;
+
+  std::vector<int> *original_clauses = nullptr; // if set, parse() appends
+                                                // the input clauses here as
+                                                // zero terminated DIMACS
+                                                // literals, to verify models
+  ProofWriter *proof = nullptr; // where learned and deleted clauses are
+                                // written, if anywhere. only supported for a
+                                // single solver without assumptions
+  Stats stats;
+  double progress_interval = 0; // seconds between progress lines, or 0 for
+                                // none
+  double next_progress = 0;     // stats.seconds() when the next line is due
+  int progress_lines = 0;       // number printed, to repeat the header
+
+  uint64_t rephase_random_state =
+      0x2545f4914f6cdd1dull; // separate from random_state, which must stay
+                             // zero to keep activities unperturbed
+
+  uint64_t random(uint64_t &state) { // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+  uint64_t random() { return random(random_state); }
+
+  void use_restart_policy(RestartPolicy policy) {
+    restart_policy = policy;
+    max_conflicts = policy == RESTART_LUBY      ? luby_unit * luby(0)
+                    : policy == RESTART_GLUCOSE ? backstop_luby_unit * luby(0)
+                                                : 100;
+  }
+
+  void add_stats(const Solver &other) { // count the search of another
+                                        // solver, such as the one of a
+                                        // component, in the statistics
+    num_conflicts += other.num_conflicts;
+    num_propagations += other.num_propagations;
+    num_restarts += other.num_restarts;
+    num_reductions += other.num_reductions;
+    num_rephases += other.num_rephases;
+    stats.add(other.stats);
+  }
+
+  void join(Portfolio &shared, int index) { // make the solver part of a
+                                            // portfolio. every solver but the
+                                            // first gets a configuration of
+                                            // its own, so that they search
+                                            // different parts of the space
+    portfolio = &shared;
+    portfolio_index = index;
+    import_cursors.assign(shared.rings.size(), 0);
+    order_heap.activity = &activity; // the solver is a copy, whose heap still
+                                     // points at the original's activities
+    if (index == 0)
+      return;
+    const RestartPolicy policies[] = {RESTART_GLUCOSE, RESTART_LUBY,
+                                      RESTART_GEOMETRIC};
+    const Value phases[] = {FALSE, TRUE, UNASSIGNED};
+    const double decays[] = {0.95, 0.9, 0.85, 0.99};
+    use_restart_policy(policies[index % 3]);
+    initial_phase = phases[(index / 3 + index) % 3];
+    activity_decay = decays[index % 4];
+    random_state = 0x9e3779b97f4a7c15ull * index;
+    rephase_random_state ^= random_state;
+  }
+
+  Value value_of(int literal) { return values[literal]; }
+
+  Value value_of_var(int var) { return values[make_literal(var, false)]; }
+
+  void set_true(int literal) { // assign a literal, and so its negation
+    values[literal] = TRUE;
+    values[negate(literal)] = FALSE;
+  }
+
+  void unassign(int var) {
+    values[make_literal(var, false)] = UNASSIGNED;
+    values[make_literal(var, true)] = UNASSIGNED;
+  }
+
+  void bump_variable(int var) { // increase a variable's activity after it was
+                                // involved in a conflict
+    activity[var] += activity_inc;
+    if (activity[var] > activity_rescale_limit) {
+      for (int i = 1; i < activity.size(); i++) {
+        activity[i] *= 1 / activity_rescale_limit; // scaling every activity by
+                                                   // the same factor keeps the
+                                                   // heap ordered
+      }
+      activity_inc *= 1 / activity_rescale_limit;
+    }
+    order_heap.increase(var);
+  }
+
+  void bump_clause(CRef ref) { // increase a clause's activity after it was
+                               // involved in a conflict
+    Clause &clause = arena[ref];
+    clause.activity += clause_activity_inc;
+    if (clause.activity > clause_activity_rescale_limit) {
+      for (CRef c : clauses) { // original clauses are bumped as reasons too,
+                               // so they have to be rescaled with the learned
+                               // ones or they would overflow
+        arena[c].activity *= 1 / clause_activity_rescale_limit;
+      }
+      clause_activity_inc *= 1 / clause_activity_rescale_limit;
+    }
+  }
+
+  void attach(CRef ref) { // add a clause to the watch lists of its first two
+                          // literals, which are its watched literals
+    Clause &clause = arena[ref];
+    std::vector<std::vector<Watcher>> &lists =
+        clause.size == 2 ? binary_watchers : watchers;
+    lists[clause[0]].push_back({ref, clause[1]});
+    lists[clause[1]].push_back({ref, clause[0]});
+  }
+
+  template <typename Trace>
+  void assign_implied(int literal,
+                      CRef reason) { // assign a literal implied by a clause
+                                     // whose other literals are all false
+    trail.push_back(literal);
+    set_true(literal);
+    if (Trace::enabled && trace.wants(TRACE_ASSIGN))
+      trace << "assigning " << var_of(literal) << " to "
+            << (is_negative(literal) ? "FALSE" : "TRUE") << "\n";
+    last_assignments[var_of(literal)] = is_negative(literal) ? FALSE : TRUE;
+    int level = trail_decisions.size() - 1;
+    if (trail_out_of_order &&
+        reason != CREF_UNDEF) { // the highest level of the other literals,
+                                // which is below the current level if they
+                                // were all kept by a chronological backjump
+      level = 0;
+      for (int other : arena[reason]) {
+        if (other != literal)
+          level = std::max(level, var_info[var_of(other)].level);
+      }
+    }
+    var_info[var_of(literal)] = {level, reason};
+    assigned_vars++;
+  }
+
+  void trace_conflict() {
+    trace << "conflict! conflict clause: [";
+    for (int literal : arena[conflict_clause]) {
+      trace << to_dimacs(literal) << ", ";
+    }
+    trace << "]\n";
+  }
+
+  void prefetch_pending() { // overlap the cache misses of the literals
+                            // queued behind trail_head, in three stages
+    int ahead = trail_head + trail_prefetch_distance;
+    if (ahead + 1 < trail.size()) { // the vectors of the watch lists
+      int false_literal = negate(trail[ahead + 1]);
+      prefetch(&watchers[false_literal]);
+      prefetch(&binary_watchers[false_literal]);
+    }
+    if (ahead < trail.size()) { // their first watchers
+      int false_literal = negate(trail[ahead]);
+      prefetch(watchers[false_literal].data());
+      prefetch(binary_watchers[false_literal].data());
+    }
+    if (trail_head + 1 < trail.size()) { // and the first clauses to visit
+      const std::vector<Watcher> &next = watchers[negate(trail[trail_head + 1])];
+      int count = std::min<int>(next.size(), watch_prefetch_distance);
+      for (int k = 0; k < count; k++) {
+        if (value_of(next[k].blocker) != TRUE)
+          prefetch(&arena[next[k].clause]);
+      }
+    }
+  }
+
+  template <typename Trace>
+  bool propagate_clauses() { // propagate any literals queued in the trail,
+                             // then the literals from any unit clauses onto
+                             // the trail
+    while (trail_head < trail.size()) {
+      int literal = trail[trail_head];
+      int false_literal = negate(literal);
+      prefetch_pending();
+
+      if (Trace::enabled && trace.wants(TRACE_PROPAGATE))
+        trace << "propagating " << to_dimacs(literal) << "...\n";
+
+      for (const Watcher &w :
+           binary_watchers[false_literal]) { // binary clauses first: these need
+                                             // nothing but the other literal,
+                                             // which is the blocker
+        Value value = value_of(w.blocker);
+        if (value == FALSE) {
+          conflict_clause = w.clause;
+          if (Trace::enabled && trace.wants(TRACE_CONFLICT))
+            trace_conflict();
+          return false;
+        } else if (value == UNASSIGNED) {
+          assign_implied<Trace>(w.blocker, w.clause);
+        }
+      }
+
+      std::vector<Watcher> &watch_list = watchers[false_literal];
+      int i = 0, j = 0; // watchers before j are kept, watchers from i onwards
+                        // have not been visited yet
+      while (i < watch_list.size()) {
+        if (i + watch_prefetch_distance < watch_list.size()) {
+          const Watcher &ahead = watch_list[i + watch_prefetch_distance];
+          if (value_of(ahead.blocker) != TRUE)
+            prefetch(&arena[ahead.clause]); // only clauses that the
+                                            // blocker will not skip
+        }
+        Watcher w = watch_list[i++];
+        if (value_of(w.blocker) == TRUE) {
+          watch_list[j++] = w;
+          continue; // clause is already satisfied, without loading it
+        }
+
+        Clause &clause = arena[w.clause];
+        if (clause[0] == false_literal) { // keep the false watch at position 1
+          clause[0] = clause[1];
+          clause[1] = false_literal;
+        }
+        int other_watch = clause[0];
+        Watcher kept = {w.clause, other_watch};
+        if (other_watch != w.blocker && value_of(other_watch) == TRUE) {
+          watch_list[j++] = kept;
+          continue; // clause is already satisfied; do nothing
+        }
+
+        int size = clause.size;
+        int k = 2;
+        if (size < long_clause_size) {
+          while (k < size && value_of(clause[k]) == FALSE) {
+            k++;
+          }
+        } else { // carry on from the last search, then wrap around
+          int start = std::min<int>(clause.search, size);
+          k = find_non_false(clause.literals(), start, size, values.data());
+          if (k == size) {
+            k = find_non_false(clause.literals(), 2, start, values.data());
+            if (k == start)
+              k = size;
+          }
+          clause.search = std::min<uint32_t>(k < size ? k : 2, max_search);
+        }
+        if (k < size) {
+          int lit = clause[k];
+          clause[1] = lit;
+          clause[k] = false_literal;
+          watchers[lit].push_back(kept);
+          continue; // found another non-false literal to watch; stop watching
+                    // this one
+        }
+
+        watch_list[j++] = kept;
+        if (value_of(other_watch) == FALSE) {
+          conflict_clause = w.clause;
+          if (Trace::enabled && trace.wants(TRACE_CONFLICT))
+            trace_conflict();
+          while (i < watch_list.size()) {
+            watch_list[j++] = watch_list[i++];
+          }
+          watch_list.resize(j);
+          return false; // all literals are false, conflict found; return false
+        } else {
+          assign_implied<Trace>(other_watch,
+                                w.clause); // all literals but one are false;
+                                           // propagate the new unit clause
+        }
+      }
+      watch_list.resize(j);
+      trail_head++;
+      num_propagations++;
+    }
+    return true;
+  }
+
+  CRef xor_clause(const uint64_t *row,
+                  int implied) { // build the clause of a row of xors under
+                                 // the current assignment: the literal of
+                                 // the implied variable (if any) first, then
+                                 // the false literals of the others
+    added_clause.clear();
+    for (int w = 0; w < xors.words; w++) {
+      for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+        int var = xors.column_vars[w * 64 + __builtin_ctzll(bits)];
+        int literal = make_literal(var, value_of_var(var) == TRUE);
+        if (var == implied) {
+          added_clause.insert(added_clause.begin(), negate(literal));
+        } else {
+          added_clause.push_back(literal);
+        }
+      }
+    }
+    return arena.alloc(added_clause, false); // not in clauses, so never
+                                             // watched or shared
+  }
+
+  CRef reason_of(int var) { // the reason clause of an implied variable,
+                            // which is only built here for literals implied
+                            // by xors. note that this may move the arena
+    CRef reason = var_info[var].reason;
+    if (reason == CREF_UNDEF || !(reason & CREF_XOR))
+      return reason;
+    reason = xor_clause(&xor_reasons[(size_t)(reason & ~CREF_XOR) * xors.words],
+                        var);
+    var_info[var].reason = reason;
+    return reason;
+  }
+
+  template <typename Trace>
+  bool propagate_xors() { // tell xors about the literals assigned since the
+                          // last call, then assign the literals implied by
+                          // the rows that changed. returns false on a
+                          // conflict
+    if (xor_conflict != CREF_UNDEF) { // analysed by now
+      arena.free(xor_conflict);
+      xor_conflict = CREF_UNDEF;
+    }
+    for (; xor_head < trail.size(); xor_head++) {
+      int literal = trail[xor_head];
+      int column = xors.column_of(var_of(literal));
+      if (column >= 0)
+        xors.assign(column, !is_negative(literal));
+    }
+    while (!xors.dirty_rows.empty()) {
+      int r = xors.dirty_rows.back();
+      xors.dirty_rows.pop_back();
+      xors.dirty[r] = false;
+      int column;
+      int parity = xors.check(r, column);
+      if (parity < 0)
+        continue;
+      int literal = column < 0 ? -1
+                               : make_literal(xors.column_vars[column],
+                                              parity == 0);
+      if (column < 0 ? parity == 0 : value_of(literal) == TRUE)
+        continue; // satisfied
+      if (column < 0 || value_of(literal) == FALSE) {
+        xor_conflict = conflict_clause = xor_clause(xors.row(r), 0);
+        if (Trace::enabled && trace.wants(TRACE_CONFLICT))
+          trace_conflict();
+        return false; // the rows left in dirty_rows are checked next time
+      }
+      xor_reasons.insert(xor_reasons.end(), xors.row(r),
+                         xors.row(r) + xors.words);
+      xor_implied.push_back(literal);
+      assign_implied<Trace>(literal, CREF_XOR | (xor_implied.size() - 1));
+      stats.xor_propagations++;
+    }
+    return true;
+  }
+
+  template <typename Trace>
+  bool propagate() { // propagate the clauses and the XOR constraints in
+                     // turn, until neither implies anything more
+    while (propagate_clauses<Trace>()) {
+      if (xors.empty() ||
+          (xor_head == trail.size() && xors.dirty_rows.empty()))
+        return true;
+      if (!propagate_xors<Trace>())
+        return false;
+    }
+    return false;
+  }
+
+  void assume(int literal) { // open a new decision level, assigning a literal
+    trail_decisions.push_back(trail.size());
+    trail.push_back(literal);
+    set_true(literal);
+    var_info[var_of(literal)].level = trail_decisions.size() - 1;
+    assigned_vars++;
+  }
+
+  template <typename Trace>
+  bool decide() { // decide the value of one variable, adding it to the trail.
+                  // returns false if every variable is already assigned
+    int var = 0;
+    while (true) {
+      if (order_heap.empty())
+        return false;
+      var = order_heap.pop();
+      if (value_of_var(var) == UNASSIGNED)
+        break; // variables that were assigned while in the heap are skipped
+               // here, since we cannot "decide" their value
+    }
+
+    Value phase = target_phases[var] != UNASSIGNED
+                      ? target_phases[var]
+                      : last_assignments[var]; // default to false if the
+                                               // variable hasnt been assigned
+                                               // yet
+    int literal = make_literal(var, phase != TRUE);
+    assume(literal);
+    stats.decisions++;
+
+    if (Trace::enabled && trace.wants(TRACE_DECIDE))
+      trace << "deciding " << to_dimacs(literal) << "...\n";
+    return true;
+  }
+
+  int compute_lbd(const int *literals,
+                  int size) { // count the distinct decision levels among the
+                              // literals
+    lbd_stamp++;
+    int lbd = 0;
+    for (int i = 0; i < size; i++) {
+      int level = var_info[var_of(literals[i])].level;
+      if (level_stamps[level] != lbd_stamp) {
+        level_stamps[level] = lbd_stamp;
+        lbd++;
+      }
+    }
+    return lbd;
+  }
+
+  Tier tier_for(int lbd) {
+    return lbd <= core_lbd_limit    ? CORE
+           : lbd <= tier2_lbd_limit ? TIER2
+                                    : LOCAL;
+  }
+
+  void clause_used(CRef ref) { // note that a clause took part in conflict
+                               // analysis. learned clauses get their LBD
+                               // recomputed, and move up a tier if it dropped
+    bump_clause(ref);
+    Clause &clause = arena[ref];
+    if (!clause.learned)
+      return;
+    clause.used = true;
+    if (clause.tier == CORE)
+      return;
+    int lbd = compute_lbd(clause.literals(), clause.size);
+    if (lbd < clause.lbd) {
+      clause.lbd = lbd;
+      clause.tier = std::min<int>(clause.tier, tier_for(lbd));
+    }
+  }
+
+  uint32_t abstract_level(int var) { // a bit standing for the decision level of
+                                     // a variable, so a set of levels can be
+                                     // tested for membership cheaply
+    return 1u << (var_info[var].level & 31);
+  }
+
+  bool redundant(int literal,
+                 uint32_t levels) { // check whether a literal of the learned
+                                    // clause is implied by the others, in which
+                                    // case it can be removed. this recursively
+                                    // follows reason clauses until every path
+                                    // ends in a literal already in the clause.
+                                    // levels is the set of abstract levels of
+                                    // the learned clause; a literal outside of
+                                    // those levels cannot be implied by it
+    analyse_stack.clear();
+    analyse_stack.push_back(literal);
+    int top = analyse_toclear.size();
+    while (!analyse_stack.empty()) {
+      int var = var_of(analyse_stack.back());
+      analyse_stack.pop_back();
+      for (int lit : arena[reason_of(var)]) {
+        int v = var_of(lit);
+        if (v == var || seen[v] || var_info[v].level == 0)
+          continue;
+        if (var_info[v].reason != CREF_UNDEF &&
+            (abstract_level(v) & levels) != 0) {
+          seen[v] = true;
+          analyse_stack.push_back(lit);
+          analyse_toclear.push_back(lit);
+        } else { // reached a decision, or a level not in the clause, so the
+                 // literal is needed. undo the marks made by this call
+          for (int i = top; i < analyse_toclear.size(); i++) {
+            seen[var_of(analyse_toclear[i])] = false;
+          }
+          analyse_toclear.resize(top);
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  const std::vector<int> &
+  analyse() { // analyse the conflict and build a learned clause that "explains"
+              // the conflict. the asserting literal (the negated first UIP) is
+              // at position 0, and the literal with the highest remaining
+              // decision level is at position 1
+    int decision_level = trail_decisions.size() - 1;
+    int current_level_count =
+        0; // number of literals from the current decision level that have
+           // been seen, but not yet resolved away. once this hits 0, the last
+           // literal resolved is the first UIP, so we stop
+
+    learned_clause.clear();
+    learned_clause.push_back(0); // placeholder for the asserting literal
+
+    CRef reason_ref = conflict_clause;
+    int uip = 0;
+    int index = trail.size() - 1;
+    do { // walk backwards through the trail, performing resolution on the
+         // learned clause on each iteration. essentially, we're replacing
+         // each literal from the current decision level with the (unseen)
+         // literals in its reason clause. literals from lower levels go
+         // straight into the learned clause, and literals from the root level
+         // are always false, so they are left out
+      clause_used(reason_ref);
+      for (int literal : arena[reason_ref]) {
+        int var = var_of(literal);
+        if (var == var_of(uip) || seen[var] || var_info[var].level == 0)
+          continue;
+        seen[var] = true;
+        if (var_info[var].level >= decision_level)
+          current_level_count++;
+        else
+          learned_clause.push_back(literal);
+      }
+
+      while (!seen[var_of(trail[index])] ||
+             var_info[var_of(trail[index])].level < decision_level) {
+        index--; // find the next literal on the trail that is in the clause.
+                 // lower levels can be interleaved after a chronological
+                 // backtrack, but those literals are in the learned clause
+      }
+      uip = trail[index--];
+      reason_ref = reason_of(var_of(uip));
+      seen[var_of(uip)] = false;
+      current_level_count--;
+    } while (current_level_count > 0);
+    learned_clause[0] = negate(uip);
+
+    analyse_toclear = learned_clause; // every literal marked in seen by now
+    uint32_t levels = 0;
+    for (int i = 1; i < learned_clause.size(); i++) {
+      levels |= abstract_level(var_of(learned_clause[i]));
+    }
+    int j = 1;
+    for (int i = 1; i < learned_clause.size();
+         i++) { // minimise the clause by removing literals implied by the
+                // rest of it
+      int var = var_of(learned_clause[i]);
+      if (var_info[var].reason == CREF_UNDEF ||
+          !redundant(learned_clause[i], levels))
+        learned_clause[j++] = learned_clause[i];
+    }
+    learned_clause.resize(j);
+
+    for (int literal : analyse_toclear) {
+      seen[var_of(literal)] = false;
+    }
+
+    for (int i = 2; i < learned_clause.size(); i++) {
+      if (var_info[var_of(learned_clause[i])].level >
+          var_info[var_of(learned_clause[1])].level)
+        std::swap(learned_clause[1], learned_clause[i]);
+    } // the second watch must be the literal from the highest remaining
+      // decision level, which is the last of them to be unassigned
+
+    learned_lbd = compute_lbd(learned_clause.data(), learned_clause.size());
+
+    for (int literal : learned_clause) {
+      bump_variable(var_of(literal));
+    }
+
+    activity_inc *= 1 / activity_decay; // rather than decaying every activity,
+                                        // make future bumps count for more
+    clause_activity_inc *= 1 / clause_activity_decay;
+
+    return learned_clause;
+  }
+
+  template <typename Trace>
+  void garbage_collect() { // move every clause that is still in use into a
+                           // fresh arena, so the clause database stays compact
+    ClauseArena to;
+    to.memory.reserve(arena.memory.size() - arena.wasted);
+
+    for (auto *lists : {&watchers, &binary_watchers}) {
+      for (std::vector<Watcher> &watch_list : *lists) {
+        for (Watcher &w : watch_list) {
+          w.clause = arena.relocate(w.clause, to);
+        }
+      }
+    }
+
+    for (int literal : trail) {
+      CRef &ref = var_info[var_of(literal)].reason;
+      if (ref != CREF_UNDEF && !(ref & CREF_XOR))
+        ref = arena.relocate(ref, to);
+    }
+    xor_conflict = CREF_UNDEF; // not carried over
+
+    for (CRef &ref : learned_clauses) {
+      ref = arena.relocate(ref, to);
+    }
+
+    for (CRef &ref : clauses) {
+      ref = arena.relocate(ref, to);
+    }
+
+    if (Trace::enabled && trace.wants(TRACE_REDUCE))
+      trace << "garbage collected " << arena.memory.size() << " -> "
+            << to.memory.size() << " words\n";
+
+    arena.memory.swap(to.memory);
+    arena.wasted = 0;
+  }
+
+  void mark_dirty(int literal) { // note that a watch list of the literal
+                                 // contains a removed clause
+    if (!dirty[literal]) {
+      dirty[literal] = true;
+      dirty_literals.push_back(literal);
+    }
+  }
+
+  void clean_watchers() { // remove every removed clause from the dirty watch
+                          // lists in a single pass over each list
+    auto removed = [this](const Watcher &w) {
+      return (bool)arena[w.clause].toRemove;
+    };
+    for (int literal : dirty_literals) {
+      for (std::vector<Watcher> *watch_list :
+           {&watchers[literal], &binary_watchers[literal]}) {
+        watch_list->erase(
+            std::remove_if(watch_list->begin(), watch_list->end(), removed),
+            watch_list->end());
+      }
+      dirty[literal] = false;
+    }
+    dirty_literals.clear();
+  }
+
+  bool locked(CRef ref) { // a clause is locked if it is the reason for a
+                          // current assignment, in which case it cannot be
+                          // deleted. implied literals of long clauses are
+                          // always at position 0, but binary clauses are
+                          // propagated without reordering
+    Clause &clause = arena[ref];
+    int implied_positions = clause.size == 2 ? 2 : 1;
+    for (int i = 0; i < implied_positions; i++) {
+      if (var_info[var_of(clause[i])].reason == ref &&
+          value_of(clause[i]) == TRUE)
+        return true;
+    }
+    return false;
+  }
+
+  template <typename Trace>
+  void reduce() { // reduce the learned clause database. core clauses are
+                  // always kept. tier 2 clauses that were not used since the
+                  // last reduction are moved to the local tier, and half of
+                  // the local clauses that were not used are removed, lowest
+                  // activity first
+    std::vector<CRef> candidates;
+    for (CRef ref : learned_clauses) {
+      Clause &clause = arena[ref];
+      if (clause.tier == TIER2 && !clause.used)
+        clause.tier = LOCAL;
+      else if (clause.tier == LOCAL && !clause.used && !locked(ref))
+        candidates.push_back(ref); // only remove a clause if it is not
+                                   // currently implying the value of a literal
+      clause.used = false;
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [this](CRef ref1, CRef ref2) {
+                return (arena[ref1].activity < arena[ref2].activity);
+              }); // sort clauses by activity
+
+    for (int i = 0; i < candidates.size() / 2; i++) {
+      arena[candidates[i]].toRemove = true;
+    }
+
+    int old_size = learned_clauses.size();
+
+    for (CRef ref : candidates) { // the watch lists of removed clauses are
+                                  // only marked here, so that each one is
+                                  // cleaned once however many of its clauses
+                                  // were removed
+      Clause &c = arena[ref];
+      if (c.toRemove) {
+        mark_dirty(c[0]);
+        mark_dirty(c[1]);
+      }
+    }
+    clean_watchers();
+
+    // remove clauses marked with toRemove from the learned_clauses and clauses
+    // lists, freeing their space in the arena
+
+    auto removed = [this](CRef ref) { return (bool)arena[ref].toRemove; };
+
+    for (CRef ref : learned_clauses) {
+      if (!removed(ref))
+        continue;
+      if (proof)
+        proof->remove(arena[ref].begin(), arena[ref].size);
+      arena.free(ref);
+    }
+
+    learned_clauses.erase(
+        std::remove_if(learned_clauses.begin(), learned_clauses.end(), removed),
+        learned_clauses.end());
+
+    clauses.erase(std::remove_if(clauses.begin(), clauses.end(), removed),
+                  clauses.end());
+
+    int new_size = learned_clauses.size();
+    stats.deleted += old_size - new_size;
+
+    if (Trace::enabled && trace.wants(TRACE_REDUCE))
+      trace << "removed " << old_size - new_size << " clauses\n";
+
+    if (arena.wasted > arena.memory.size() / 5) // only compact once a good
+                                                // fraction of the arena is
+                                                // unused
+      garbage_collect<Trace>();
+  }
+
+  void backtrack(int level) { // unassign every variable above a decision
+                              // level. literals of lower levels assigned out
+                              // of order stay on the trail, and are
+                              // propagated again
+    if (level >= trail_decisions.size() - 1)
+      return;
+    int start = trail_decisions[level + 1];
+    if (!xors.empty()) { // without chronological backtracking, every literal
+                         // from start onwards is unassigned
+      while (!xor_implied.empty() &&
+             var_info[var_of(xor_implied.back())].level > level) {
+        CRef reason = var_info[var_of(xor_implied.back())].reason;
+        if (!(reason & CREF_XOR))
+          arena.free(reason); // built by reason_of()
+        xor_implied.pop_back();
+      }
+      xor_reasons.resize(xor_implied.size() * xors.words);
+      for (int i = start; i < xor_head; i++) {
+        int column = xors.column_of(var_of(trail[i]));
+        if (column >= 0)
+          xors.unassign(column);
+      }
+      xor_head = std::min(xor_head, start);
+    }
+    int kept = 0;
+    for (int i = trail.size() - 1; i >= start; i--) {
+      int variable = var_of(trail[i]);
+      if (var_info[variable].level <= level) {
+        kept++; // only after a chronological backtrack
+        continue;
+      }
+      unassign(variable);
+      assigned_vars--;
+      var_info[variable] = VarInfo();
+      order_heap.insert(variable);
+    }
+    if (kept > 0) {
+      int j = start;
+      for (int i = start; i < trail.size(); i++) {
+        if (value_of(trail[i]) == TRUE)
+          trail[j++] = trail[i];
+      }
+    }
+    trail.resize(start + kept);
+    trail_decisions.resize(level + 1);
+    trail_head = std::min<int>(trail_head, start);
+    if (level == 0)
+      trail_out_of_order = false;
+  }
+
+  double luby(int i) { // the ith element of the luby sequence (from 0)
+    int size = 1, seq = 0; // find the finite subsequence containing i
+    while (size < i + 1) {
+      seq++;
+      size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+      size = (size - 1) >> 1;
+      seq--;
+      i = i % size;
+    }
+    return std::pow(2, seq);
+  }
+
+  bool restart_due() {
+    switch (restart_policy) {
+    case RESTART_GEOMETRIC:
+    case RESTART_LUBY:
+      return conflicts_since_restart >= max_conflicts;
+    case RESTART_GLUCOSE:
+      return (conflicts_since_restart >= restart_min_conflicts &&
+              lbd_fast.value > restart_margin * lbd_slow.value) ||
+             conflicts_since_restart >= max_conflicts;
+    }
+    return false;
+  }
+
+  void update_phases() { // after a conflict, once back at its level: the
+                         // trail before that level is conflict-free, so it
+                         // may be a new target or best assignment
+    int assigned = trail_decisions.back();
+    if (assigned <= target_assigned)
+      return; // best_assigned is never below target_assigned
+    for (int i = 0; i < assigned; i++) {
+      target_phases[var_of(trail[i])] = is_negative(trail[i]) ? FALSE : TRUE;
+    }
+    target_assigned = assigned;
+    if (assigned > best_assigned) {
+      for (int i = 0; i < assigned; i++) {
+        best_phases[var_of(trail[i])] = is_negative(trail[i]) ? FALSE : TRUE;
+      }
+      best_assigned = assigned;
+    }
+  }
+
+  template <typename Trace> void rephase() { // reset the saved phases, so the
+                                             // search moves to another part
+                                             // of the space
+    Rephase kind = rephase_schedule[num_rephases % (sizeof(rephase_schedule) /
+                                                    sizeof(Rephase))];
+    num_rephases++;
+    next_rephase = num_conflicts + rephase_interval * (num_rephases + 1);
+    if (Trace::enabled && trace.wants(TRACE_RESTART))
+      trace << "rephasing (" << (int)kind << ")...\n";
+
+    if (kind == REPHASE_WALK) {
+      if (walk_enabled) {
+        int unsatisfied = walk(walk_effort *
+                               (num_propagations - walk_propagations));
+        if (Trace::enabled && trace.wants(TRACE_RESTART))
+          trace << "local search left " << unsatisfied
+                << " clauses unsatisfied\n";
+      }
+      kind = walk_enabled ? REPHASE_WALK : REPHASE_BEST;
+    }
+    for (int var = 1; var <= num_vars && kind != REPHASE_WALK; var++) {
+      switch (kind) {
+      case REPHASE_ORIGINAL:
+      case REPHASE_INVERTED: {
+        Value phase = initial_phase; // a random phase has no inverse
+        if (phase == UNASSIGNED)
+          phase = random(rephase_random_state) & 1 ? TRUE : FALSE;
+        else if (kind == REPHASE_INVERTED)
+          phase = phase == TRUE ? FALSE : TRUE;
+        last_assignments[var] = phase;
+        break;
+      }
+      case REPHASE_BEST:
+        if (best_phases[var] != UNASSIGNED)
+          last_assignments[var] = best_phases[var];
+        break;
+      case REPHASE_RANDOM:
+        last_assignments[var] = random(rephase_random_state) & 1 ? TRUE : FALSE;
+        break;
+      case REPHASE_WALK:
+        break; // already set by walk()
+      }
+    }
+    std::fill(target_phases.begin(), target_phases.end(), UNASSIGNED);
+    target_assigned = 0;
+    if (kind == REPHASE_BEST)
+      best_assigned = 0; // look for a new best from here
+  }
+
+  int reuse_trail_level() { // find how many decision levels can be kept
+                            // when restarting. the variable with the highest
+                            // activity would be decided first after a
+                            // restart, so levels whose decisions are more
+                            // active than it would be decided again in the
+                            // same order anyway
+    while (!order_heap.empty() &&
+           value_of_var(order_heap.top()) != UNASSIGNED) {
+      order_heap.pop(); // assigned variables are reinserted when unassigned
+    }
+    if (order_heap.empty())
+      return trail_decisions.size() - 1;
+    double next_activity = activity[order_heap.top()];
+    int level = std::min<int>(
+        assumptions.size(),
+        trail_decisions.size() - 1); // assumptions are always kept, since
+                                     // they would be assumed again
+    while (level + 1 < trail_decisions.size() &&
+           activity[var_of(trail[trail_decisions[level + 1]])] >
+               next_activity) {
+      level++;
+    }
+    return level;
+  }
+
+  template <typename Trace> void restart() {
+    bool forced = restart_policy == RESTART_GLUCOSE &&
+                  conflicts_since_restart >= max_conflicts;
+    int level = forced ? 0
+                       : reuse_trail_level(); // a forced restart keeps no
+                                              // levels. the LBD test never
+                                              // firing means the search is
+                                              // stuck, and a reused trail
+                                              // would repeat its decisions
+    if (Trace::enabled && trace.wants(TRACE_RESTART))
+      trace << "reached " << conflicts_since_restart
+            << " conflicts! restarting, keeping " << level
+            << " decision levels...\n";
+
+    backtrack(level); // the root decision level is always kept, since its
+                      // assignments hold regardless of any decisions
+
+    num_restarts++;
+    conflicts_since_restart = 0;
+    if (restart_policy == RESTART_GEOMETRIC) {
+      max_conflicts *= 1.5; // geometric restart strategy - increase number of
+                            // conflicts required for a restart with each
+                            // restart
+    } else if (restart_policy == RESTART_LUBY) {
+      max_conflicts = luby_unit * luby(num_restarts);
+    } else if (forced) {
+      num_forced_restarts++;
+      max_conflicts = backstop_luby_unit * luby(num_forced_restarts);
+    }
+    if (Trace::enabled && trace.wants(TRACE_RESTART) &&
+        (restart_policy != RESTART_GLUCOSE || forced))
+      trace << "setting restart threshold to " << max_conflicts << "\n";
+    import_pending = portfolio != nullptr;
+  }
+
+  bool probe_root(int literal) { // a literal is worth probing if assigning it
+                                 // implies others through binary clauses, but
+                                 // no binary clause implies it, so the probe
+                                 // covers everything implied below it
+    return !binary_watchers[negate(literal)].empty() &&
+           binary_watchers[literal].empty();
+  }
+
+  CRef add_learned(const std::vector<int> &literals) { // add a learned clause
+                                                       // found at the root
+                                                       // level, whose literals
+                                                       // are all unassigned
+    if (proof)
+      proof->add(literals);
+    CRef c = arena.alloc(literals, true);
+    arena[c].tier = tier_for(arena[c].lbd);
+    clauses.push_back(c);
+    learned_clauses.push_back(c);
+    attach(c);
+    return c;
+  }
+
+  template <typename Trace>
+  bool probe(long long limit) { // failed literal probing. each root literal and
+                                // its negation are assumed in turn: if either
+                                // leads to a conflict, the other holds, and
+                                // literals implied by both hold too. literals
+                                // implied with opposite values by the two
+                                // probes are equivalent to the probed
+                                // literal, which is recorded as a pair of
+                                // binary clauses. returns false on a conflict
+                                // at the root level
+    std::vector<int> units, equivalent;
+    int num_units = 0, num_equivalent = 0;
+    for (int n = 0; n < num_vars && num_propagations < limit; n++) {
+      int var = probe_cursor;
+      probe_cursor = probe_cursor % num_vars + 1;
+      if (eliminated[var] || value_of_var(var) != UNASSIGNED)
+        continue;
+      int literal = make_literal(var, false);
+      if (!probe_root(literal)) {
+        literal = negate(literal);
+        if (!probe_root(literal))
+          continue;
+      }
+
+      units.clear();
+      equivalent.clear();
+      assume(literal);
+      bool failed = !propagate<Trace>();
+      probe_stamp++;
+      for (int i = trail_decisions[1]; i < trail.size(); i++) {
+        probe_stamps[trail[i]] = probe_stamp;
+      }
+      backtrack(0);
+
+      if (failed) {
+        units.push_back(negate(literal));
+      } else {
+        assume(negate(literal));
+        if (!propagate<Trace>()) {
+          units.push_back(literal);
+        } else {
+          for (int i = trail_decisions[1] + 1; i < trail.size(); i++) {
+            if (probe_stamps[trail[i]] == probe_stamp)
+              units.push_back(trail[i]);
+            else if (probe_stamps[negate(trail[i])] == probe_stamp)
+              equivalent.push_back(trail[i]);
+          }
+        }
+        backtrack(0);
+      }
+
+      for (int x : equivalent) { // literal implies -x, and -literal implies x
+        add_learned({literal, x});
+        add_learned({negate(literal), negate(x)});
+        num_equivalent++;
+      }
+      for (int unit : units) {
+        if (value_of(unit) == UNASSIGNED) {
+          if (proof && var_of(unit) != var_of(literal)) {
+            int implication[] = {negate(literal), unit}; // implied by both
+                                                         // probes, which is
+                                                         // only a unit
+                                                         // consequence once
+                                                         // one is recorded
+            proof->add(implication, 2);
+            proof->add(&unit, 1);
+            proof->remove(implication, 2);
+          } else if (proof) {
+            proof->add(&unit, 1);
+          }
+          assign_implied<Trace>(unit, CREF_UNDEF); // root level assignments
+                                                   // never need a reason
+          num_units++;
+        }
+      }
+      if (!propagate<Trace>())
+        return false;
+    }
+
+    if (Trace::enabled && trace.wants(TRACE_INPROCESS))
+      trace << "probing found " << num_units << " units and " << num_equivalent
+            << " equivalences\n";
+    return true;
+  }
+
+  template <typename Trace>
+  bool vivify(long long limit) { // shorten tier 2 learned clauses. the negation
+                                 // of each literal is assumed in turn; literals
+                                 // that become false are redundant, and once a
+                                 // literal becomes true or a conflict is
+                                 // found the remaining literals are too.
+                                 // returns false on a conflict at the root
+                                 // level
+    std::vector<CRef> candidates;
+    for (CRef ref : learned_clauses) {
+      Clause &clause = arena[ref];
+      if (clause.tier == TIER2 && !clause.vivified && clause.size > 2)
+        candidates.push_back(ref);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [this](CRef ref1, CRef ref2) {
+                return arena[ref1].lbd < arena[ref2].lbd;
+              }); // the clauses most likely to be kept are shortened first
+
+    std::vector<int> literals, shortened;
+    int num_shortened = 0, num_removed = 0;
+    for (CRef ref : candidates) {
+      if (num_propagations >= limit)
+        break;
+      if (locked(ref))
+        continue;
+      arena[ref].vivified = true;
+      literals.assign(arena[ref].begin(), arena[ref].end());
+      shortened.clear();
+      bool satisfied = false;
+      for (int literal : literals) {
+        Value value = value_of(literal);
+        if (value == TRUE) {
+          if (trail_decisions.size() == 1)
+            satisfied = true; // true at the root level, so the clause is
+                              // never needed again
+          else
+            shortened.push_back(literal);
+          break;
+        }
+        if (value == FALSE)
+          continue;
+        shortened.push_back(literal);
+        assume(negate(literal));
+        if (!propagate<Trace>())
+          break;
+      }
+      backtrack(0);
+
+      if (!satisfied && shortened.size() == literals.size())
+        continue;
+      Clause &clause = arena[ref];
+      clause.toRemove = true;
+      mark_dirty(clause[0]);
+      mark_dirty(clause[1]);
+      if (satisfied) {
+        num_removed++;
+      } else if (shortened.size() == 1) {
+        if (proof)
+          proof->add(shortened);
+        assign_implied<Trace>(shortened[0], CREF_UNDEF);
+        num_shortened++;
+        if (!propagate<Trace>())
+          return false;
+      } else {
+        int lbd = std::min<int>(clause.lbd, shortened.size());
+        CRef c = add_learned(shortened); // may move the arena
+        arena[c].lbd = lbd;
+        arena[c].tier = tier_for(lbd);
+        arena[c].vivified = true;
+        num_shortened++;
+      }
+    }
+
+    clean_watchers();
+    auto removed = [this](CRef ref) { return (bool)arena[ref].toRemove; };
+    for (CRef ref : learned_clauses) {
+      if (!removed(ref))
+        continue;
+      if (proof) // only now, since a shortened clause may be derived from
+                 // the clause it replaces
+        proof->remove(arena[ref].begin(), arena[ref].size);
+      arena.free(ref);
+    }
+    learned_clauses.erase(
+        std::remove_if(learned_clauses.begin(), learned_clauses.end(), removed),
+        learned_clauses.end());
+    clauses.erase(std::remove_if(clauses.begin(), clauses.end(), removed),
+                  clauses.end());
+
+    if (Trace::enabled && trace.wants(TRACE_INPROCESS))
+      trace << "vivification shortened " << num_shortened << " and removed "
+            << num_removed << " of " << candidates.size() << " clauses\n";
+    return true;
+  }
+
+  template <typename Trace>
+  bool inprocess() { // simplify the clause database at the root level, spending
+                     // a bounded share of the propagations made since the last
+                     // run. returns false if the formula was found to be
+                     // unsatisfiable
+    inprocess_pending = false;
+    next_inprocess = num_conflicts + inprocess_interval;
+    backtrack(0);
+    if (!propagate<Trace>())
+      return false;
+
+    long long effort = std::max<long long>(
+        inprocess_min_effort,
+        inprocess_effort * (num_propagations - inprocess_propagations));
+    long long start = num_propagations;
+    if (!probe<Trace>(start + effort / 2) ||
+        !vivify<Trace>(num_propagations + effort / 2))
+      return false;
+    inprocess_propagations = num_propagations;
+
+    if (Trace::enabled && trace.wants(TRACE_INPROCESS))
+      trace << "inprocessing spent " << num_propagations - start
+            << " propagations\n";
+    return true;
+  }
+
+  template <typename Trace>
+  bool add_shared(std::vector<int> &clause) { // add a clause imported from
+                                              // another solver at the root
+                                              // level. returns false if it
+                                              // is falsified there
+    int j = 0;
+    for (int literal : clause) {
+      Value value = value_of(literal);
+      if (value == TRUE)
+        return true; // already satisfied, so the clause is not needed
+      if (value == UNASSIGNED)
+        clause[j++] = literal;
+    }
+    clause.resize(j);
+    if (clause.empty())
+      return false;
+    if (clause.size() == 1) {
+      assign_implied<Trace>(clause[0], CREF_UNDEF);
+      return true;
+    }
+    CRef c = add_learned(clause);
+    arena[c].tier = TIER2; // only kept while it is of use to this solver
+    return true;
+  }
+
+  template <typename Trace>
+  bool import_shared() { // add the clauses exported by the other solvers of
+                         // the portfolio since the last import. returns false
+                         // if the formula was found to be unsatisfiable
+    import_pending = false;
+    std::vector<ExportRing> &rings = portfolio->rings;
+    bool fresh = false;
+    for (int i = 0; i < rings.size(); i++) {
+      if (i != portfolio_index &&
+          rings[i].head.load(std::memory_order_acquire) != import_cursors[i])
+        fresh = true;
+    }
+    if (!fresh)
+      return true;
+
+    backtrack(0); // shared clauses are checked against the root assignment
+    for (int i = 0; i < rings.size(); i++) {
+      if (i == portfolio_index)
+        continue;
+      uint64_t head = rings[i].head.load(std::memory_order_acquire);
+      uint64_t &next = import_cursors[i];
+      if (head - next > ExportRing::capacity)
+        next = head - ExportRing::capacity; // older clauses are overwritten
+      for (; next < head; next++) {
+        if (rings[i].read(next, shared_clause) &&
+            !add_shared<Trace>(shared_clause))
+          return false;
+      }
+    }
+    return propagate<Trace>();
+  }
+
+  template <typename Trace>
+  void backjump(
+      const std::vector<int> &learned_clause) { // after a conflict, jump back
+                                                // to the decision that caused
+                                                // it
+
+    int uip = learned_clause[0]; // after backjumping, the UIP (asserting
+                                 // literal) will be propagated
+    int highest_decision_level =
+        learned_clause.size() == 1
+            ? 0
+            : var_info[var_of(learned_clause[1])].level; // analyse() puts
+                                                         // the highest
+                                                         // remaining level at
+                                                         // position 1
+    int current_level = trail_decisions.size() - 1;
+    int target_level = highest_decision_level;
+    if (current_level - highest_decision_level > chrono_threshold &&
+        highest_decision_level > 0 && assumptions.empty() &&
+        xors.empty()) { // undoing that many levels would mostly
+                        // re-propagate the same literals. the UIP still gets
+                        // the lower level, out of order
+      target_level = current_level - 1;
+      trail_out_of_order = true;
+      stats.chronological++;
+    }
+
+    if (Trace::enabled && trace.wants(TRACE_BACKJUMP))
+      trace << "backjumping to decision level " << target_level << "...\n";
+
+    backtrack(target_level);
+
+    if (learned_clause.size() != 1) {
+      CRef c = arena.alloc(learned_clause, true);
+      arena[c].lbd = std::min<uint32_t>(learned_lbd, max_lbd);
+      arena[c].tier = tier_for(learned_lbd);
+      clauses.push_back(c);
+      attach(c);
+      learned_clauses.push_back(c);
+    } else {
+      CRef c = arena.alloc(learned_clause, true);
+      arena[c].lbd = std::min<uint32_t>(learned_lbd, max_lbd);
+      arena[c].tier = tier_for(learned_lbd);
+      clauses.push_back(c);
+      learned_clauses.push_back(c); // unit clauses are never watched, since
+                                    // they stay assigned at the root decision
+                                    // level
+    }
+    if (proof)
+      proof->add(learned_clause);
+    stats.learned++;
+    stats.learned_literals += learned_clause.size();
+    stats.learned_lbd += learned_lbd;
+    if (portfolio && (learned_clause.size() == 1 ||
+                      (learned_lbd <= share_lbd_limit &&
+                       learned_clause.size() <= share_size_limit)))
+      portfolio->rings[portfolio_index].push(learned_clause.data(),
+                                             learned_clause.size());
+    if (learn && learned_clause.size() <= learn_max_size) {
+      learn_buffer.clear();
+      for (int literal : learned_clause) {
+        learn_buffer.push_back(to_dimacs(literal));
+      }
+      learn_buffer.push_back(0);
+      learn(learn_data, learn_buffer.data());
+    }
+
+    trail.push_back(uip);
+    trail_head = std::min<int>(trail_head, trail.size() - 1);
+    var_info[var_of(uip)] = {highest_decision_level, clauses.back()};
+    set_true(uip);
+    last_assignments[var_of(uip)] = is_negative(uip) ? FALSE : TRUE;
+    assigned_vars++;
+
+    if (num_conflicts >= next_reduction) {
+      num_reductions++;
+      next_reduction +=
+          reduction_threshold +
+          reduction_increment * num_reductions; // reductions become less
+                                                // frequent over time, so useful
+                                                // clauses can accumulate
+      uint64_t start = cycles();
+      reduce<Trace>();
+      stats.phase_cycles[PHASE_REDUCE] += cycles() - start;
+    }
+
+    conflicts_since_restart++;
+    lbd_fast.update(learned_lbd);
+    lbd_slow.update(learned_lbd);
+    if (restart_due()) {
+      restart<Trace>();
+      if (num_conflicts >= next_rephase)
+        rephase<Trace>();
+      if (num_conflicts >= next_inprocess)
+        inprocess_pending = true;
+    }
+  }
+
+  void parse(const char *path); // see solver.cpp
+  void fill_walker(Walker &walker); // the irredundant clauses, simplified by
+                                    // the root assignment
+  int walk(long long effort); // run local search from the saved phases and
+                              // save the best assignment it finds. returns
+                              // the number of clauses that leaves
+                              // unsatisfied
+  void print_progress();        // write a line of the periodic progress table
+  void print_stats() const;     // write the final summary as comment lines
+  void print_stats_json() const; // write the final summary as a JSON object
+
+  template <typename Trace>
+  bool preprocess() { // simplify the parsed clauses. returns false if the
+                      // formula was found to be unsatisfiable
+    eliminated.resize(num_vars + 1);
+    if (!preprocess_enabled || empty_clause ||
+        clauses.size() > preprocess_clause_limit)
+      return !empty_clause;
+
+    int old_size = clauses.size();
+    uint64_t start = cycles();
+    bool simplified = simplify(arena, clauses, eliminated, elimination_stack,
+                               num_vars, proof);
+    stats.phase_cycles[PHASE_PREPROCESS] += cycles() - start;
+    if (!simplified) {
+      empty_clause = true;
+      return false;
+    }
+    garbage_collect<Trace>(); // nothing refers to clauses yet but the clause
+                              // list, which the collector updates
+
+    if (Trace::enabled && trace.wants(TRACE_PREPROCESS)) {
+      int num_eliminated = std::count(eliminated.begin(), eliminated.end(), 1);
+      trace << "preprocessing eliminated " << num_eliminated
+            << " variables and reduced " << old_size << " clauses to "
+            << clauses.size() << "\n";
+    }
+    return true;
+  }
+
+  void extend_model() { // build the model from the current assignment
+    model.resize(num_vars + 1);
+    for (int var = 1; var <= num_vars; var++) {
+      model[var] = value_of_var(var) == TRUE ? TRUE : FALSE;
+    }
+    restore_eliminated();
+  }
+
+  void restore_eliminated() { // give the eliminated variables values
+                              // satisfying their removed clauses in the
+                              // model, most recently eliminated first
+    for (int i = elimination_stack.size() - 1; i > 0;) {
+      int size = elimination_stack[i];
+      int start = i - size;
+      bool satisfied = false;
+      for (int j = start; j < i && !satisfied; j++) {
+        int literal = elimination_stack[j];
+        satisfied =
+            model[var_of(literal)] == (is_negative(literal) ? FALSE : TRUE);
+      }
+      if (!satisfied) {
+        int pivot = elimination_stack[start];
+        model[var_of(pivot)] = is_negative(pivot) ? FALSE : TRUE;
+      }
+      i = start - 1;
+    }
+  }
+
+  void grow(int vars) { // make room in the per-variable arrays for every
+                        // variable up to vars. new variables start unassigned
+    if (!values.empty() && vars <= allocated_vars)
+      return;
+    int first = values.empty() ? 1 : allocated_vars + 1;
+
+    values.resize(2 * (vars + 1) + value_padding,
+                  UNASSIGNED); // variables are 1-indexed, so the literals of
+                               // variable 0 are unused
+    last_assignments.resize(
+        vars + 1,
+        initial_phase == TRUE
+            ? TRUE
+            : FALSE); // last assignment defaults to false (since if a
+                      // variable hasn't been assigned before, we try
+                      // assigning false to it first when deciding its
+                      // value), unless another phase was configured
+    target_phases.resize(vars + 1, UNASSIGNED);
+    best_phases.resize(vars + 1, UNASSIGNED);
+    var_info.resize(vars + 1);
+    seen.resize(vars + 1);
+    level_stamps.resize(vars + 1);
+    activity.resize(vars + 1, 1);
+    eliminated.resize(vars + 1);
+    watchers.resize(
+        2 * (vars + 1)); // the watchers array is indexed over each literal
+                         // (i.e. positive and negative propositional
+                         // variables)
+    binary_watchers.resize(2 * (vars + 1));
+    dirty.resize(2 * (vars + 1));
+    probe_stamps.resize(2 * (vars + 1));
+    assumption_failed.resize(2 * (vars + 1));
+    order_heap.activity = &activity;
+
+    for (int var = first; var <= vars; var++) {
+      if (random_state != 0) {
+        activity[var] += (random() % 1024) * 1e-6;
+        if (initial_phase == UNASSIGNED)
+          last_assignments[var] = random() & 1 ? TRUE : FALSE;
+      }
+      if (!eliminated[var]) // eliminated variables no longer occur in any
+                            // clause
+        order_heap.insert(var);
+    }
+    allocated_vars = vars;
+    num_vars = std::max(num_vars, vars);
+  }
+
+  bool initialise() { // initialise any important variables, and watch or
+                      // assign the clauses added so far. returns false if
+                      // the formula is found to be unsatisfiable
+    uint64_t start = cycles();
+    initialised = true;
+    grow(num_vars);
+
+    trail_decisions.push_back(
+        0); // the root decision level begins at trail index 0
+    if (empty_clause)
+      return false;
+
+    for (int i = 0; i < clauses.size() && !empty_clause; i++) {
+      Clause &clause = arena[clauses[i]];
+      if (clause.size == 1) {
+        int literal = clause[0];
+        if (value_of(literal) == UNASSIGNED) {
+          trail.push_back(literal); // unit clause, so add its literal to the
+                                    // trail to be propagated
+          set_true(literal);
+          var_info[var_of(literal)].level = 0;
+          assigned_vars++;
+        } else if (value_of(literal) == FALSE) {
+          empty_clause = true;
+        }
+      } else {
+        attach(clauses[i]); // the first two literals are the watched literals
+      }
+    }
+    if (gauss_enabled && !proof && !empty_clause &&
+        !find_xors(arena, clauses, num_vars, xors))
+      empty_clause = true;
+    stats.xors = xors.num_rows();
+
+    stats.phase_cycles[PHASE_INITIALISE] += cycles() - start;
+    return !empty_clause;
+  }
+
+  void add_clause(const std::vector<int> &clause) { // add a clause of DIMACS
+                                                    // literals. once the
+                                                    // solver is initialised,
+                                                    // the clause is simplified
+                                                    // by the root assignment
+                                                    // and watched straight
+                                                    // away
+    std::vector<int> &literals = added_clause;
+    literals.clear();
+    int max_var = 0;
+    for (int literal : clause) {
+      literals.push_back(from_dimacs(literal));
+      max_var = std::max(max_var, std::abs(literal));
+    }
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()),
+                   literals.end());
+    for (int i = 1; i < literals.size(); i++) {
+      if (literals[i] == negate(literals[i - 1]))
+        return; // a literal and its negation are adjacent once sorted, and
+                // make the clause a tautology
+    }
+
+    if (!initialised) {
+      num_vars = std::max(num_vars, max_var);
+      if (literals.empty())
+        empty_clause = true;
+      else
+        clauses.push_back(arena.alloc(literals, false));
+      return;
+    }
+
+    grow(max_var);
+    backtrack(0);
+    int j = 0;
+    for (int literal : literals) {
+      if (value_of(literal) == TRUE)
+        return; // satisfied at the root level, so never needed
+      if (value_of(literal) == UNASSIGNED)
+        literals[j++] = literal;
+    }
+    literals.resize(j);
+    if (literals.empty()) {
+      empty_clause = true;
+    } else if (literals.size() == 1) {
+      assign_implied<NoTrace>(literals[0], CREF_UNDEF);
+    } else {
+      CRef c = arena.alloc(literals, false);
+      clauses.push_back(c);
+      attach(c);
+    }
+  }
+
+  template <typename Trace = NoTrace>
+  Result solve(const std::vector<int> &assumed =
+                   {}) { // search for a model in which the assumed DIMACS
+                         // literals are true. learned clauses, activities and
+                         // saved phases are kept for the next call
+    for (int literal : failed_assumptions) {
+      assumption_failed[literal] = false;
+    }
+    failed_assumptions.clear();
+    if (!initialised)
+      initialise();
+    if (empty_clause)
+      return RESULT_UNSAT;
+
+    backtrack(0);
+    assumptions.clear();
+    for (int literal : assumed) {
+      grow(std::abs(literal));
+      assumptions.push_back(from_dimacs(literal));
+    }
+    level_stamps.resize(std::max<size_t>(
+        level_stamps.size(),
+        num_vars + assumptions.size() + 1)); // assumptions that are already
+                                             // true get empty levels
+    if (walk_enabled && stats.walks == 0 && assumptions.empty()) {
+      int unsatisfied = walk(0); // cheap next to the search, and enough to
+                                 // solve many easy satisfiable formulas
+      if (Trace::enabled && trace.wants(TRACE_RESTART))
+        trace << "local search left " << unsatisfied
+              << " clauses unsatisfied\n";
+    }
+
+    Result result = sat_loop<Trace>();
+    if (result == RESULT_UNSAT && failed_assumptions.empty())
+      empty_clause = true; // unsatisfiable regardless of the assumptions, so
+                           // every later call is too
+    else if (result == RESULT_SAT)
+      extend_model();
+    return result;
+  }
+
+  Value value(int literal) const { // value of a DIMACS literal in the model
+                                   // found by the last solve() call
+    int var = std::abs(literal);
+    if (var >= model.size())
+      return UNASSIGNED;
+    return literal > 0 ? model[var] : model[var] == TRUE ? FALSE : TRUE;
+  }
+
+  bool failed(int literal) const { // whether an assumption of the last solve()
+                                   // call was used to show the formula
+                                   // unsatisfiable under the assumptions
+    int internal = from_dimacs(literal);
+    return internal < assumption_failed.size() && assumption_failed[internal];
+  }
+
+  void mark_failed(int literal) {
+    if (!assumption_failed[literal]) {
+      assumption_failed[literal] = true;
+      failed_assumptions.push_back(literal);
+    }
+  }
+
+  void analyse_final(int literal) { // a false assumption was reached. walk
+                                    // back through the trail to find the
+                                    // assumptions that imply its negation
+    mark_failed(literal);
+    int var = var_of(literal);
+    if (var_info[var].level == 0)
+      return;
+    seen[var] = true;
+    for (int i = trail.size() - 1; i >= trail_decisions[1]; i--) {
+      int v = var_of(trail[i]);
+      if (!seen[v])
+        continue;
+      if (var_info[v].reason ==
+          CREF_UNDEF) { // every decision so far is an assumption
+        mark_failed(trail[i]);
+      } else {
+        for (int lit : arena[reason_of(v)]) {
+          if (var_of(lit) != v && var_info[var_of(lit)].level > 0)
+            seen[var_of(lit)] = true;
+        }
+      }
+      seen[v] = false;
+    }
+  }
+
+  bool assume_next() { // decide the next assumption. returns false if it is
+                       // false, after analyse_final() found the assumptions
+                       // responsible
+    int literal = assumptions[trail_decisions.size() - 1];
+    Value current = value_of(literal);
+    if (current == FALSE) {
+      analyse_final(literal);
+      return false;
+    }
+    if (current == TRUE)
+      trail_decisions.push_back(trail.size()); // already true, so its level is
+                                               // left empty
+    else
+      assume(literal);
+    return true;
+  }
+
+  int lookahead(int literal) { // number of literals assigned by assuming a
+                               // literal, or -1 if that leads to a conflict
+    int before = trail.size();
+    assume(literal);
+    bool consistent = propagate<NoTrace>();
+    int count = trail.size() - before;
+    backtrack(trail_decisions.size() - 2);
+    return consistent ? count : -1;
+  }
+
+  void split(int depth, const std::vector<int> &candidates,
+             std::vector<int> &cube,
+             std::vector<Cube> &cubes) { // extend the cube of the current
+                                         // decisions by depth more splits
+    int best = 0;
+    long long best_score = -1;
+    for (int var : candidates) {
+      if (value_of_var(var) != UNASSIGNED)
+        continue;
+      int positive = lookahead(make_literal(var, false));
+      int negative = lookahead(make_literal(var, true));
+      if (positive < 0 || negative < 0) { // a failed literal, so only the
+                                          // other value needs a cube
+        if (positive < 0 && negative < 0)
+          return; // both fail, so the cube is already refuted
+        best = make_literal(var, positive < 0);
+        best_score = -2;
+        break;
+      }
+      long long score = (long long)(positive + 1) *
+                        (negative + 1); // split on the variable that
+                                        // simplifies both branches most
+      if (score > best_score) {
+        best = make_literal(var, false);
+        best_score = score;
+      }
+    }
+
+    if (best_score == -2) { // forced, so the cube grows without splitting
+      assume(best);
+      if (propagate<NoTrace>()) {
+        cube.push_back(best);
+        split(depth, candidates, cube, cubes);
+        cube.pop_back();
+      }
+      backtrack(trail_decisions.size() - 2);
+      return;
+    }
+    if (depth == 0 || best_score < 0) { // deep enough, or every candidate is
+                                        // assigned
+      cubes.emplace_back();
+      for (int literal : cube) {
+        cubes.back().push_back(to_dimacs(literal));
+      }
+      return;
+    }
+    for (int literal : {best, negate(best)}) {
+      assume(literal);
+      if (propagate<NoTrace>()) {
+        cube.push_back(literal);
+        split(depth - 1, candidates, cube, cubes);
+        cube.pop_back();
+      }
+      backtrack(trail_decisions.size() - 2);
+    }
+  }
+
+  bool make_cubes(int depth,
+                  std::vector<Cube> &cubes) { // split the formula into cubes
+                                              // of up to depth splits, which
+                                              // together cover every model.
+                                              // returns false if the formula
+                                              // is unsatisfiable at the root
+                                              // level
+    if (!initialised)
+      initialise();
+    if (empty_clause || !propagate<NoTrace>())
+      return false;
+
+    std::vector<int> occurrences(num_vars + 1);
+    for (CRef ref : clauses) {
+      for (int literal : arena[ref]) {
+        occurrences[var_of(literal)]++;
+      }
+    }
+    std::vector<int> candidates;
+    for (int var = 1; var <= num_vars; var++) {
+      if (!eliminated[var] && value_of_var(var) == UNASSIGNED)
+        candidates.push_back(var);
+    }
+    size_t kept = std::min<size_t>(candidates.size(), lookahead_candidates);
+    std::partial_sort(candidates.begin(), candidates.begin() + kept,
+                      candidates.end(), [&occurrences](int a, int b) {
+                        return occurrences[a] > occurrences[b];
+                      });
+    candidates.resize(kept);
+
+    std::vector<int> cube;
+    split(depth, candidates, cube, cubes);
+    return true;
+  }
+
+  bool stop_requested() { // whether the search should give up
+    return (portfolio && portfolio->stop.load(std::memory_order_relaxed)) ||
+           (terminate && terminate(terminate_data));
+  }
+
+  template <typename Trace>
+  Result sat_loop() { // loop that continually propagates variables,
+                      // analysing conflicts or deciding variables when
+                      // appropriate
+    while (true) {
+      uint64_t start = cycles();
+      bool consistent = propagate<Trace>();
+      stats.phase_cycles[PHASE_PROPAGATE] += cycles() - start;
+      if (consistent) { // propagate unit clauses. if propagate returns true,
+                        // no conflict was found
+        if (trail_decisions.size() - 1 < assumptions.size()) {
+          if (!assume_next())
+            return RESULT_UNSAT; // unsatisfiable under the assumptions
+        } else if (!decide<Trace>()) { // if all variables have been assigned,
+                                       // satisfiable
+          return RESULT_SAT;
+        }
+      } else {
+        num_conflicts++;
+        int conflict_level = 0; // below the current level if literals were
+                                // kept by a chronological backtrack
+        for (int literal : arena[conflict_clause]) {
+          conflict_level =
+              std::max(conflict_level, var_info[var_of(literal)].level);
+        }
+        if (conflict_level == 0) {
+          return RESULT_UNSAT; // conflict at root decision level means unsat
+        }
+        backtrack(conflict_level); // analyse() works on the conflict level
+        update_phases();
+        start = cycles();
+        const std::vector<int> &learned_clause = analyse();
+        stats.phase_cycles[PHASE_ANALYSE] += cycles() - start;
+        backjump<Trace>(learned_clause);
+        if (inprocess_pending) {
+          start = cycles();
+          bool refuted = !inprocess<Trace>();
+          stats.phase_cycles[PHASE_INPROCESS] += cycles() - start;
+          if (refuted)
+            return RESULT_UNSAT; // inprocessing found a conflict at the root
+                                 // level
+        }
+        if (import_pending && !import_shared<Trace>())
+          return RESULT_UNSAT;
+        if (stop_requested())
+          return RESULT_UNKNOWN; // e.g. another solver of the portfolio
+                                 // finished first
+        if (progress_interval > 0 && num_conflicts % 256 == 0 &&
+            stats.seconds() >= next_progress)
+          print_progress(); // the clock is only read every so often
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,62 @@
+#!/bin/sh
+# run.sh - check fieldSAT's answers on the formulas in this directory
+#
+# usage: tests/run.sh SOLVER [OPTIONS...]
+#
+# each formula has a "c expect SAT" or "c expect UNSAT" line. SOLVER is run
+# on each, with OPTIONS, reading the formula from stdin, and must give the
+# expected answer within TEST_TIMEOUT seconds (60 by default). a model printed
+# on v lines is checked against the clauses. exits 1 if any formula fails
+
+solver=$1
+shift
+dir=$(dirname "$0")
+timeout=${TEST_TIMEOUT:-60}
+failed=0
+
+for formula in "$dir"/*.cnf; do
+  name=$(basename "$formula" .cnf)
+  expected=$(sed -n 's/^c expect \([A-Z]*\).*/\1/p' "$formula")
+  output=$(timeout "$timeout" "$solver" "$@" < "$formula")
+  status=$?
+  answer=$(printf '%s\n' "$output" |
+    sed -n 's/^\(s \)\{0,1\}\(SATISFIABLE\|UNSATISFIABLE\)$/\2/p' | head -n 1)
+  case $answer in
+  SATISFIABLE) answer=SAT ;;
+  UNSATISFIABLE) answer=UNSAT ;;
+  *) answer="no answer (exit status $status)" ;;
+  esac
+
+  if [ "$answer" != "$expected" ]; then
+    echo "FAIL $name: expected $expected, got $answer"
+    failed=1
+    continue
+  fi
+  if [ "$answer" = SAT ] && printf '%s\n' "$output" | grep -q '^v '; then
+    # every clause needs a literal the model makes true
+    model=$(printf '%s\n' "$output" | sed -n 's/^v //p')
+    if ! awk -v model="$model" '
+        BEGIN {
+          n = split(model, literals)
+          for (i = 1; i <= n; i++) true_literal[literals[i]] = 1
+        }
+        /^[cp%]/ { next }
+        {
+          for (i = 1; i <= NF; i++) {
+            if ($i == 0) {
+              if (!satisfied) exit 1
+              satisfied = 0
+            } else if ($i in true_literal) {
+              satisfied = 1
+            }
+          }
+        }' "$formula"; then
+      echo "FAIL $name: the model does not satisfy the formula"
+      failed=1
+      continue
+    fi
+  fi
+  echo "ok   $name: $answer"
+done
+
+exit $failed
@@ -0,0 +1,188 @@
+/* walk.cpp - stochastic local search
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#include "walk.h"
+
+#include <algorithm>
+#include <cmath>
+
+Walker::Walker() {
+  starts.push_back(0);
+  for (int b = 0; b <= walk_break_limit; b++) {
+    probabilities[b] = std::pow(walk_eps + b, -walk_cb);
+  }
+}
+
+void Walker::add_clause(const int *clause, int size) {
+  literals.insert(literals.end(), clause, clause + size);
+  starts.push_back(literals.size());
+}
+
+void Walker::build(int vars) {
+  num_vars = vars;
+  num_literals = literals.size();
+  occurrence_starts.assign(2 * (vars + 1) + 1, 0);
+  for (int literal : literals) {
+    occurrence_starts[literal + 1]++;
+  }
+  for (int i = 1; i < occurrence_starts.size(); i++) {
+    occurrence_starts[i] += occurrence_starts[i - 1];
+  }
+  occurrences.resize(literals.size());
+  std::vector<int> next(occurrence_starts.begin(), occurrence_starts.end() - 1);
+  for (int c = 0; c + 1 < starts.size(); c++) {
+    for (int i = starts[c]; i < starts[c + 1]; i++) {
+      occurrences[next[literals[i]]++] = c;
+    }
+  }
+}
+
+uint64_t Walker::random() { // xorshift64
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 7;
+  random_state ^= random_state << 17;
+  return random_state;
+}
+
+void Walker::mark_unsatisfied(int clause) {
+  positions[clause] = unsatisfied.size();
+  unsatisfied.push_back(clause);
+}
+
+void Walker::mark_satisfied(int clause) {
+  int last = unsatisfied.back();
+  unsatisfied[positions[clause]] = last;
+  positions[last] = positions[clause];
+  unsatisfied.pop_back();
+}
+
+void Walker::flip(int var) {
+  values[var] ^= 1;
+  int true_literal = 2 * var + !values[var];
+  for (int i = occurrence_starts[true_literal];
+       i < occurrence_starts[true_literal + 1]; i++) {
+    int clause = occurrences[i];
+    int count = true_counts[clause]++;
+    if (count == 0) {
+      mark_satisfied(clause);
+      break_counts[var]++;
+    } else if (count == 1) {
+      break_counts[critical[clause]]--; // no longer the only true literal
+    }
+    critical[clause] ^= var;
+  }
+  int false_literal = true_literal ^ 1;
+  for (int i = occurrence_starts[false_literal];
+       i < occurrence_starts[false_literal + 1]; i++) {
+    int clause = occurrences[i];
+    int count = true_counts[clause]--;
+    critical[clause] ^= var;
+    if (count == 1) {
+      mark_unsatisfied(clause);
+      break_counts[var]--;
+    } else if (count == 2) {
+      break_counts[critical[clause]]++; // now the only true literal
+    }
+  }
+  ticks += occurrence_starts[true_literal + 1] -
+           occurrence_starts[true_literal] +
+           occurrence_starts[false_literal + 1] -
+           occurrence_starts[false_literal];
+
+  if (!best_stale) {
+    since_best.push_back(var);
+    if ((int)since_best.size() > num_vars) {
+      best_stale = true; // copying every value is as cheap by now
+      since_best.clear();
+    }
+  }
+}
+
+void Walker::save_best() { // the current values are the best so far
+  if (best_stale) {
+    best = values;
+  } else {
+    for (int var : since_best) {
+      best[var] ^= 1; // a variable flipped twice is flipped back
+    }
+  }
+  since_best.clear();
+  best_stale = false;
+}
+
+int Walker::walk(std::vector<char> &assignment, long long effort,
+                 uint64_t seed, const std::atomic<bool> *stop) {
+  random_state = seed != 0 ? seed : 1; // xorshift never leaves zero
+  int num_clauses = starts.size() - 1;
+  values.assign(assignment.begin(), assignment.end());
+  values.resize(num_vars + 1);
+  true_counts.assign(num_clauses, 0);
+  critical.assign(num_clauses, 0);
+  break_counts.assign(num_vars + 1, 0);
+  positions.assign(num_clauses, -1);
+  unsatisfied.clear();
+  for (int c = 0; c < num_clauses; c++) {
+    for (int i = starts[c]; i < starts[c + 1]; i++) {
+      int literal = literals[i];
+      if (values[literal >> 1] != (literal & 1)) {
+        true_counts[c]++;
+        critical[c] ^= literal >> 1;
+      }
+    }
+    if (true_counts[c] == 0)
+      mark_unsatisfied(c);
+    else if (true_counts[c] == 1)
+      break_counts[critical[c]]++;
+  }
+  ticks += num_literals;
+
+  best = values;
+  since_best.clear();
+  best_stale = false;
+  size_t fewest = unsatisfied.size();
+  long long limit = ticks + effort;
+  long long steps = 0;
+  while (!unsatisfied.empty() && ticks < limit) {
+    if (stop && (++steps & 1023) == 0 &&
+        stop->load(std::memory_order_relaxed))
+      break;
+    int clause = unsatisfied[random() % unsatisfied.size()];
+    int size = starts[clause + 1] - starts[clause];
+    const int *literal = &literals[starts[clause]];
+    scores.resize(size);
+    double total = 0; // pick a literal with a probability that falls
+                      // polynomially with its break count
+    for (int i = 0; i < size; i++) {
+      int breaks = std::min(break_counts[literal[i] >> 1], walk_break_limit);
+      total += scores[i] = probabilities[breaks];
+    }
+    ticks += size;
+    double pick = (random() >> 11) * 0x1.0p-53 * total;
+    int i = 0;
+    while (i + 1 < size && (pick -= scores[i]) > 0) {
+      i++;
+    }
+    flip(literal[i] >> 1);
+    flips++;
+    if (unsatisfied.size() < fewest) {
+      fewest = unsatisfied.size();
+      save_best();
+    }
+  }
+
+  assignment.assign(best.begin(), best.end());
+  return fewest;
+}
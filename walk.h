@@ -0,0 +1,82 @@
+/* walk.h - stochastic local search
+Copyright (C) 2025 fieldbox
+
+This program is free software: you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.*/
+
+
+#ifndef FIELDSAT_WALK_H
+#define FIELDSAT_WALK_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+const int walk_break_limit = 64; // break counts above this all get the
+                                 // probability of this one
+const double walk_cb = 2.06;     // ProbSAT polynomial break weight
+const double walk_eps = 0.9;     // ProbSAT polynomial break offset
+
+struct Walker { // ProbSAT local search over a fixed set of clauses, using
+                // the solver's literal encoding. a clause is unsatisfied
+                // until one of its literals is true; the break count of a
+                // variable is the number of clauses in which it is the only
+                // true literal, so flipping it would unsatisfy them
+  int num_vars = 0;
+  std::vector<int> literals; // every clause's literals, one after another
+  std::vector<int> starts;   // where each clause begins in literals, with
+                             // the end of the last as a final entry
+  std::vector<int> occurrence_starts; // where the occurrences of each literal
+                                      // begin in occurrences, indexed by
+                                      // literal, with an end entry
+  std::vector<int> occurrences;       // clauses containing each literal
+  long long num_literals = 0;
+
+  std::vector<char> values;        // current value of each variable
+  std::vector<int> true_counts;    // true literals in each clause
+  std::vector<int> critical;       // xor of the variables of the true
+                                   // literals of each clause, which is the
+                                   // only one's variable when its count is 1
+  std::vector<int> break_counts;   // indexed by variable
+  std::vector<int> unsatisfied;    // clauses with no true literal
+  std::vector<int> positions;      // index of each clause in unsatisfied
+  std::vector<char> best;          // values when unsatisfied was smallest
+  std::vector<int> since_best;     // variables flipped since then, unless
+                                   // there were too many to keep track of
+  bool best_stale = false;         // set once since_best overflowed
+  std::vector<double> scores;      // of the literals of the picked clause
+  double probabilities[walk_break_limit + 1];
+  uint64_t random_state = 1;
+
+  long long flips = 0; // over every walk() call
+  long long ticks = 0; // occurrences and literals visited, the unit of effort
+
+  Walker();
+  void add_clause(const int *clause, int size); // before build()
+  void build(int vars); // set up the occurrence lists of the clauses added
+  int walk(std::vector<char> &assignment, long long effort, uint64_t seed,
+           const std::atomic<bool> *stop =
+               nullptr); // search from the assignment to each variable
+                         // (1 for true), until every clause is satisfied,
+                         // the effort in ticks is spent or stop is set.
+                         // the assignment is replaced by the best one found,
+                         // and the number of clauses it leaves unsatisfied
+                         // is returned
+
+  uint64_t random();
+  void mark_unsatisfied(int clause);
+  void mark_satisfied(int clause);
+  void flip(int var);
+  void save_best();
+};
+
+#endif